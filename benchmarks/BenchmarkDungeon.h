@@ -0,0 +1,49 @@
+#ifndef BENCHMARKDUNGEON_H
+#define BENCHMARKDUNGEON_H
+
+#include "BenchmarkMaze.h"
+#include "Enemy.h"
+#include "Player.h"
+#include "SlotMap.h"
+#include "SimulationContext.h"
+#include "TileTypes.h"
+
+const int DUNGEON_CELL_SIZE = 96;
+
+// A dungeon level without Game: walls answer the way Game::isWall does for
+// the maze, and damage lands without the dodge roll
+class BenchmarkDungeon : public SimulationContext {
+public:
+    explicit BenchmarkDungeon(int size) : maze(makeMaze(size)), cells(openCells(maze)) {}
+
+    bool isWall(float x, float y) override {
+        int mazeX = static_cast<int>(x + 32) / DUNGEON_CELL_SIZE;
+        int mazeY = static_cast<int>(y + 64) / DUNGEON_CELL_SIZE;
+        return !maze.inBounds(mazeX, mazeY) || dungeonCellDescriptor(maze[mazeY][mazeX]).solid;
+    }
+    const Grid<int>& getDungeonMaze() const override { return maze; }
+    void applyDamage(Entity&, Entity& target, int damage) override { target.takeDamage(damage); }
+
+    // Player standing in the middle open cell
+    Player makePlayer() {
+        auto [x, y] = cells[cells.size() / 2];
+        return Player(states, x * DUNGEON_CELL_SIZE - 32.0f, y * DUNGEON_CELL_SIZE - 64.0f, NO_SPRITE_SHEET, 4, 0.1f);
+    }
+
+    // `count` enemies spread over the open cells, placed like Game::spawnEnemiesInDungeon
+    void spawnEnemies(SlotMap<Enemy>& enemies, int count, PathfindingManager& pathfinding) {
+        enemies.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            auto [x, y] = cells[(static_cast<size_t>(i) * 7919) % cells.size()];
+            enemies.emplace(states, x * DUNGEON_CELL_SIZE - 32.0f, y * DUNGEON_CELL_SIZE - 64.0f, NO_SPRITE_SHEET, 8, 0.1f, pathfinding);
+        }
+    }
+
+    EntityStates states;    // Declared first in each benchmark, so it outlives the entities
+
+private:
+    Grid<int> maze;
+    std::vector<std::pair<int, int>> cells;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef BENCHMARKMAZE_H
+#define BENCHMARKMAZE_H
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "MazeGenerator.h"
+#include "Random.h"
+
+// Maze edge lengths from the first level (21) up to far past anything the game generates
+inline void MazeSizes(benchmark::internal::Benchmark* benchmark) {
+    for (int size : {21, 51, 101, 201, 501}) {
+        benchmark->Arg(size);
+    }
+}
+
+// Same seed, same maze, so runs stay comparable over time
+inline Grid<int> makeMaze(int size, uint64_t seed = 1) {
+    Random rng(seed);
+    MazeGenerator generator(size, size, rng);
+    return generator.generateMaze();
+}
+
+inline std::vector<std::pair<int, int>> openCells(const Grid<int>& maze) {
+    std::vector<std::pair<int, int>> cells;
+    for (int y = 0; y < maze.getHeight(); ++y) {
+        for (int x = 0; x < maze.getWidth(); ++x) {
+            if (maze[y][x] != -1) cells.emplace_back(x, y);
+        }
+    }
+    return cells;
+}
+
+#endif
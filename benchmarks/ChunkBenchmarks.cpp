@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "Chunk.h"
+#include "ChunkStore.h"
+
+const int CHUNK_SIZE = 12;   // Tiles per chunk edge, as in World
+
+static Chunk makeChunk() {
+    std::vector<std::vector<int>> tiles(CHUNK_SIZE, std::vector<int>(CHUNK_SIZE, 0));
+    for (int i = 0; i < CHUNK_SIZE; ++i) {
+        tiles[i][i] = 1;  // Not uniform, so the chunk keeps a real tile buffer
+    }
+    return Chunk::fromMatrix(tiles);
+}
+
+static void BM_ChunkFromMatrix(benchmark::State& state) {
+    std::vector<std::vector<int>> tiles(CHUNK_SIZE, std::vector<int>(CHUNK_SIZE, 0));
+    tiles[0][0] = 1;
+
+    for (auto _ : state) {
+        Chunk chunk = Chunk::fromMatrix(tiles);
+        benchmark::DoNotOptimize(chunk.data());
+    }
+}
+BENCHMARK(BM_ChunkFromMatrix);
+
+// Chunks leaving and re-entering the active window, kept in memory
+static void BM_ChunkStoreRoundTrip(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    ChunkStore store("", count, 12, 0);
+    Chunk chunk = makeChunk();
+    Chunk loaded;
+
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            store.store(i % 64, i / 64, chunk);
+        }
+        for (int i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(store.load(i % 64, i / 64, loaded));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ChunkStoreRoundTrip)->RangeMultiplier(4)->Range(1, 4096);
+
+// A copy that gets written to detaches from the shared buffer
+static void BM_ChunkCopyOnWrite(benchmark::State& state) {
+    Chunk base = makeChunk();
+
+    for (auto _ : state) {
+        Chunk copy = base;
+        copy.setTile(0, 1, 2);
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+BENCHMARK(BM_ChunkCopyOnWrite);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "BenchmarkDungeon.h"
+#include "Clock.h"
+#include "Collision.h"
+#include "ProjectileSystem.h"
+
+const float STEP_SECONDS = 1.0f / 60.0f;
+const int VOLLEY_ARROWS = 256;          // Player arrows fired from across the maze each iteration
+const int VOLLEY_SPELLS = 128;          // Spells cast by enemies at the player
+const int VOLLEY_STEPS = 30;            // Steps each volley is flown for
+const int ENEMIES_ON_PLAYER = 8;        // Enemies put back on top of the player before every pass
+
+// ProjectileSystem::update with every arrow tested against the enemies
+// through its broad phase, and spells homing on the player
+static void BM_ProjectileUpdate(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    BenchmarkDungeon dungeon(101);
+    PathfindingManager pathfinding;
+    Player player = dungeon.makePlayer();
+    Player archer = dungeon.makePlayer();   // Moved around the maze to fire from everywhere
+    SlotMap<Enemy> enemies;
+    dungeon.spawnEnemies(enemies, count, pathfinding);
+
+    ProjectileSystem projectiles;
+    std::vector<ProjectileHit> hits;
+    Random rng(5);
+    SimulationClock::reset();
+
+    for (auto _ : state) {
+        projectiles.clear();
+        for (int i = 0; i < VOLLEY_ARROWS; ++i) {
+            const Enemy& aim = enemies[rng.nextBelow(static_cast<uint32_t>(enemies.size()))];
+            archer.setX(aim.getX() + (i % 2 ? 200.0f : -200.0f));
+            archer.setY(aim.getY());
+            projectiles.fireArrow(archer, i % 2 ? Entity::Left : Entity::Right, Player::ARROW_DAMAGE);
+        }
+        for (int i = 0; i < VOLLEY_SPELLS && i < count; ++i) {
+            Enemy& caster = enemies[i];
+            projectiles.fireSpell(caster, caster.getX(), caster.getY(), player.getX(), player.getY(),
+                                  Enemy::SPELL_SPEED, Enemy::SPELL_DURATION, caster.getSpellDamage(), 13);
+        }
+
+        for (int step = 0; step < VOLLEY_STEPS; ++step) {
+            SimulationClock::advance(STEP_SECONDS);
+            hits.clear();
+            projectiles.update(STEP_SECONDS, player, enemies, dungeon.getDungeonMaze(), hits);
+            benchmark::DoNotOptimize(hits.data());
+        }
+    }
+    state.counters["step_time"] = benchmark::Counter(VOLLEY_STEPS, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    SimulationClock::reset();
+}
+BENCHMARK(BM_ProjectileUpdate)->RangeMultiplier(10)->Range(1, 10000)->Unit(benchmark::kMicrosecond);
+
+// The per-step player against every enemy pass from Game::step, with a few
+// enemies overlapping the player so separation runs too
+static void BM_PlayerEnemyCollisions(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    BenchmarkDungeon dungeon(101);
+    PathfindingManager pathfinding;
+    Player player = dungeon.makePlayer();
+    float startX = player.getX();
+    float startY = player.getY();
+    SlotMap<Enemy> enemies;
+    dungeon.spawnEnemies(enemies, count, pathfinding);
+
+    for (auto _ : state) {
+        player.setX(startX);
+        player.setY(startY);
+        for (int i = 0; i < ENEMIES_ON_PLAYER && i < count; ++i) {
+            enemies[i].setX(startX + (i % 3 - 1) * 20.0f);
+            enemies[i].setY(startY + (i / 3 - 1) * 20.0f);
+        }
+        resolvePlayerEnemyCollisions(player, enemies, dungeon);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PlayerEnemyCollisions)->RangeMultiplier(10)->Range(1, 10000);
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkDungeon.h"
+#include "Clock.h"
+#include <algorithm>
+#include <chrono>
+
+const float STEP_SECONDS = 1.0f / 60.0f;
+const int STEPS_PER_ITERATION = 120;   // One shared path refresh interval, so every iteration pays for one refresh
+
+// The enemy half of Game::step: interpolation snapshot, then every enemy's AI,
+// movement and animation. `step_time` is the cost of one simulation step and
+// `worst_step` the slowest one; at 10k enemies both have to fit a frame.
+// Path refreshes are staggered, so the worst step is close to the average.
+static void BM_EnemyUpdate(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    BenchmarkDungeon dungeon(101);
+    PathfindingManager pathfinding;
+    Player player = dungeon.makePlayer();
+    SlotMap<Enemy> enemies;
+    dungeon.spawnEnemies(enemies, count, pathfinding);
+    SimulationClock::reset();
+    SimulationClock::advance(STEP_SECONDS);  // So the first refresh lands inside the first iteration
+
+    double worstStep = 0.0;
+    for (auto _ : state) {
+        for (int step = 0; step < STEPS_PER_ITERATION; ++step) {
+            auto stepStart = std::chrono::steady_clock::now();
+            SimulationClock::advance(STEP_SECONDS);
+            dungeon.states.savePreviousPositions();
+            for (auto& enemy : enemies) {
+                enemy.updateBehavior(STEP_SECONDS, player, dungeon);
+            }
+            worstStep = std::max(worstStep, std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * STEPS_PER_ITERATION * count);
+    state.counters["step_time"] = benchmark::Counter(STEPS_PER_ITERATION, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["worst_step"] = worstStep;
+    SimulationClock::reset();
+}
+BENCHMARK(BM_EnemyUpdate)->RangeMultiplier(10)->Range(1, 10000)->Unit(benchmark::kMillisecond);
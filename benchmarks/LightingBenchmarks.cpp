@@ -0,0 +1,43 @@
+#include "BenchmarkMaze.h"
+#include "LightGeometry.h"
+
+const int TILE_SIZE = 96;
+const int LIGHT_RAYS = 240;          // Rays per enemy or spell light
+const float LIGHT_RADIUS = 300.0f;
+const int LIGHTING_MAZE_SIZE = 51;   // Maze at difficulty 30
+
+static void BM_BuildWallGrid(benchmark::State& state) {
+    auto maze = makeMaze(static_cast<int>(state.range(0)));
+    LightGeometry geometry;
+
+    for (auto _ : state) {
+        geometry.setWalls(maze, TILE_SIZE);
+    }
+    state.counters["walls"] = static_cast<double>(geometry.getObstacleCount());
+}
+BENCHMARK(BM_BuildWallGrid)->Apply(MazeSizes)->Unit(benchmark::kMicrosecond);
+
+// One frame of ray casting with N lights spread over open cells
+static void BM_CastLightRays(benchmark::State& state) {
+    int lights = static_cast<int>(state.range(0));
+    auto maze = makeMaze(LIGHTING_MAZE_SIZE);
+    auto cells = openCells(maze);
+    LightGeometry geometry;
+    geometry.setWalls(maze, TILE_SIZE);
+
+    Random rng(3);
+    std::vector<Vec2> positions;
+    for (int i = 0; i < lights; ++i) {
+        auto cell = cells[rng.nextBelow(static_cast<uint32_t>(cells.size()))];
+        positions.push_back({cell.first * TILE_SIZE + TILE_SIZE / 2.0f, cell.second * TILE_SIZE + TILE_SIZE / 2.0f});
+    }
+
+    for (auto _ : state) {
+        for (const Vec2& position : positions) {
+            auto rays = geometry.castRays(position, LIGHT_RADIUS, LIGHT_RAYS);
+            benchmark::DoNotOptimize(rays.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lights * LIGHT_RAYS);  // Rays per second
+}
+BENCHMARK(BM_CastLightRays)->RangeMultiplier(2)->Range(1, 128)->Arg(200)->Unit(benchmark::kMicrosecond);
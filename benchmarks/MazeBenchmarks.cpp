@@ -0,0 +1,53 @@
+#include "BenchmarkMaze.h"
+#include "TiledMazeGenerator.h"
+
+static void BM_GenerateMaze(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    Random rng(1);
+
+    for (auto _ : state) {
+        MazeGenerator generator(size, size, rng);
+        auto maze = generator.generateMaze();
+        benchmark::DoNotOptimize(maze.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);  // Cells per second
+}
+BENCHMARK(BM_GenerateMaze)->Apply(MazeSizes)->Unit(benchmark::kMicrosecond);
+
+// Every generator from the first level up to a 4k x 4k map, to see which ones scale
+static void BM_GenerateMazeAlgorithm(benchmark::State& state) {
+    MazeAlgorithm algorithm = static_cast<MazeAlgorithm>(state.range(0));
+    int size = static_cast<int>(state.range(1));
+    Random rng(1);
+
+    for (auto _ : state) {
+        MazeGenerator generator(size, size, rng, algorithm);
+        auto maze = generator.generateMaze();
+        benchmark::DoNotOptimize(maze.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);  // Cells per second
+    state.SetLabel(mazeAlgorithmName(algorithm));
+}
+BENCHMARK(BM_GenerateMazeAlgorithm)
+    ->ArgsProduct({ benchmark::CreateDenseRange(0, static_cast<int>(MazeAlgorithm::Count) - 1, 1),
+                    { 21, 201, 1025, 4095 } })
+    ->ArgNames({ "algorithm", "size" })
+    ->Unit(benchmark::kMillisecond);
+
+// The tiled generator on a growing number of workers; same maze for every count
+static void BM_GenerateMazeTiled(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    int threads = static_cast<int>(state.range(1));
+
+    for (auto _ : state) {
+        TiledMazeGenerator generator(size, size, 1, threads);
+        auto maze = generator.generateMaze();
+        benchmark::DoNotOptimize(maze.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);  // Cells per second
+}
+BENCHMARK(BM_GenerateMazeTiled)
+    ->ArgsProduct({ { 1025, 4095 }, { 1, 2, 4, 8, 16 } })
+    ->ArgNames({ "size", "threads" })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
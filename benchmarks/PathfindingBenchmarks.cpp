@@ -0,0 +1,56 @@
+#include "BenchmarkMaze.h"
+#include "Pathfinding.h"
+
+// Corner to corner: the longest search an enemy can start in a maze this size
+static void BM_FindPathAcrossMaze(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto maze = makeMaze(size);
+    auto cells = openCells(maze);
+    auto start = cells.front();
+    auto goal = cells.back();
+
+    size_t length = 0;
+    for (auto _ : state) {
+        auto path = findPath(maze, start.first, start.second, goal.first, goal.second);
+        length = path.size();
+        benchmark::DoNotOptimize(path.data());
+    }
+    state.counters["path_length"] = static_cast<double>(length);
+}
+BENCHMARK(BM_FindPathAcrossMaze)->Apply(MazeSizes)->Unit(benchmark::kMicrosecond);
+
+// Many short searches from random cells, as a crowd of enemies closing in would issue
+static void BM_FindPathRandomPairs(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto maze = makeMaze(size);
+    auto cells = openCells(maze);
+    Random rng(2);
+
+    for (auto _ : state) {
+        auto start = cells[rng.nextBelow(static_cast<uint32_t>(cells.size()))];
+        auto goal = cells[rng.nextBelow(static_cast<uint32_t>(cells.size()))];
+        auto path = findPath(maze, start.first, start.second, goal.first, goal.second);
+        benchmark::DoNotOptimize(path.data());
+    }
+}
+BENCHMARK(BM_FindPathRandomPairs)->Apply(MazeSizes)->Unit(benchmark::kMicrosecond);
+
+// One distance field and a path read off it from every open cell: what a wave
+// of enemy refreshes costs the PathfindingManager while the player stands still
+static void BM_PathsFromEveryCell(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto maze = makeMaze(size);
+    auto cells = openCells(maze);
+    auto goal = cells[cells.size() / 2];
+    Grid<int> distances;
+
+    for (auto _ : state) {
+        distancesToGoal(maze, goal.first, goal.second, distances);
+        for (const auto& cell : cells) {
+            auto path = pathDownDistances(distances, cell.first, cell.second);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cells.size()));
+}
+BENCHMARK(BM_PathsFromEveryCell)->Arg(21)->Arg(51)->Arg(101)->Unit(benchmark::kMicrosecond);  // Cells times path length; the large mazes take seconds
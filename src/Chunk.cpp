@@ -0,0 +1,91 @@
+#include "Chunk.h"
+#include <algorithm>
+
+Chunk::Chunk() {}
+
+Chunk::Chunk(int width, int height, uint8_t fill)
+    : storage(std::make_shared<Storage>(Storage{width, height, true, fill, {}, nullptr, nullptr, false})) {}
+
+Chunk Chunk::fromMatrix(const std::vector<std::vector<int>>& matrix) {
+    int height = static_cast<int>(matrix.size());
+    int width = height > 0 ? static_cast<int>(matrix[0].size()) : 0;
+    return fromMatrix(matrix, 0, 0, width, height);
+}
+
+Chunk Chunk::fromMatrix(const std::vector<std::vector<int>>& matrix, int left, int top, int width, int height) {
+    Chunk chunk;
+    chunk.storage = std::make_shared<Storage>(Storage{width, height, false, 0, {}, nullptr, nullptr, false});
+    chunk.storage->tiles.resize(static_cast<size_t>(width) * height);
+    chunk.storage->data = chunk.storage->tiles.data();
+
+    for (int y = 0; y < height && top + y < static_cast<int>(matrix.size()); ++y) {
+        const std::vector<int>& row = matrix[top + y];
+        for (int x = 0; x < width && left + x < static_cast<int>(row.size()); ++x) {
+            chunk.storage->tiles[y * width + x] = static_cast<uint8_t>(row[left + x]);
+        }
+    }
+
+    chunk.compact();
+    return chunk;
+}
+
+Chunk Chunk::fromView(int width, int height, const uint8_t* tiles, std::shared_ptr<const void> owner) {
+    Chunk chunk;
+    chunk.storage = std::make_shared<Storage>(Storage{width, height, false, 0, {}, tiles, std::move(owner), false});
+    return chunk;
+}
+
+void Chunk::setTile(int x, int y, uint8_t tile) {
+    if (getTile(x, y) == tile) return;
+
+    detach();
+    if (storage->uniform) {
+        storage->tiles.assign(static_cast<size_t>(storage->width) * storage->height, storage->fill);
+        storage->data = storage->tiles.data();
+        storage->uniform = false;
+    }
+    storage->tiles[y * storage->width + x] = tile;
+    storage->modified = true;
+}
+
+size_t Chunk::memoryUsage() const {
+    if (!storage) return 0;
+    return sizeof(Storage) + storage->tiles.capacity();
+}
+
+bool Chunk::operator==(const Chunk& other) const {
+    if (storage == other.storage) return true;
+    if (!storage || !other.storage) return false;
+    if (storage->width != other.storage->width || storage->height != other.storage->height) return false;
+
+    for (int y = 0; y < storage->height; ++y) {
+        for (int x = 0; x < storage->width; ++x) {
+            if (getTile(x, y) != other.getTile(x, y)) return false;
+        }
+    }
+    return true;
+}
+
+void Chunk::detach() {
+    if (storage.use_count() == 1 && !storage->owner) return;
+
+    auto copy = std::make_shared<Storage>(Storage{storage->width, storage->height, storage->uniform, storage->fill, {}, nullptr, nullptr, storage->modified});
+    if (!storage->uniform) {
+        copy->tiles.assign(storage->data, storage->data + static_cast<size_t>(storage->width) * storage->height);
+        copy->data = copy->tiles.data();
+    }
+    storage = std::move(copy);
+}
+
+void Chunk::compact() {
+    auto& tiles = storage->tiles;
+    if (tiles.empty()) return;
+
+    uint8_t first = tiles[0];
+    if (std::all_of(tiles.begin(), tiles.end(), [first](uint8_t tile) { return tile == first; })) {
+        storage->uniform = true;
+        storage->fill = first;
+        storage->data = nullptr;
+        std::vector<uint8_t>().swap(tiles);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef CHUNK_H
+#define CHUNK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Tile storage for a single world chunk.
+// Tiles are stored one byte each in one contiguous buffer. Copies of a chunk
+// share that buffer and only detach when one of them is written to
+// (copy-on-write), so identical chunks cost a pointer each.
+class Chunk {
+public:
+    Chunk();
+    Chunk(int width, int height, uint8_t fill = 0);
+
+    static Chunk fromMatrix(const std::vector<std::vector<int>>& matrix);
+
+    // Copies the width x height window of `matrix` whose top-left is (left, top)
+    static Chunk fromMatrix(const std::vector<std::vector<int>>& matrix, int left, int top, int width, int height);
+
+    // Wraps tiles that live in externally owned memory (e.g. a mapped region
+    // file) without copying them. `owner` keeps that memory alive.
+    static Chunk fromView(int width, int height, const uint8_t* tiles, std::shared_ptr<const void> owner);
+
+    int getWidth() const { return storage ? storage->width : 0; }
+    int getHeight() const { return storage ? storage->height : 0; }
+    bool empty() const { return !storage; }
+
+    uint8_t getTile(int x, int y) const {
+        return storage->uniform ? storage->fill : storage->data[y * storage->width + x];
+    }
+    void setTile(int x, int y, uint8_t tile);
+
+    bool isUniform() const { return storage && storage->uniform; }
+    uint8_t getFill() const { return storage->fill; }
+    bool isView() const { return storage && storage->owner != nullptr; }
+    // Tiles were written since the chunk was built or paged in
+    bool isModified() const { return storage && storage->modified; }
+    const uint8_t* data() const { return storage && !storage->uniform ? storage->data : nullptr; }
+    bool sharesStorageWith(const Chunk& other) const { return storage == other.storage; }
+
+    // Heap bytes used by the tile buffer (shared buffers are reported in full,
+    // mapped views report none)
+    size_t memoryUsage() const;
+
+    bool operator==(const Chunk& other) const;
+    bool operator!=(const Chunk& other) const { return !(*this == other); }
+
+private:
+    // A chunk whose tiles are all the same value keeps only that value
+    // (single-entry palette) until a different tile is written.
+    struct Storage {
+        int width;
+        int height;
+        bool uniform;
+        uint8_t fill;
+        std::vector<uint8_t> tiles;
+        const uint8_t* data;                 // tiles.data() or the mapped view
+        std::shared_ptr<const void> owner;   // Set only for mapped views
+        bool modified;
+    };
+
+    std::shared_ptr<Storage> storage;
+
+    void detach();
+    void compact();
+};
+
+#endif // CHUNK_H
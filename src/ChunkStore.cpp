@@ -0,0 +1,333 @@
+#include "ChunkStore.h"
+#include "Profiler.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const char REGION_MAGIC[4] = {'G', 'M', 'R', 'G'};
+const uint32_t REGION_VERSION = 2;
+const int SLOTS_PER_REGION = ChunkStore::REGION_SIZE * ChunkStore::REGION_SIZE;
+
+const uint8_t SLOT_PRESENT = 1;
+const uint8_t SLOT_UNIFORM = 2;
+
+struct RegionHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t chunkSize;
+    uint64_t sourceHash;    // Of the map the chunks were cut from
+};
+
+// One entry of the slot table that follows the header. Tile bytes for
+// non-uniform chunks are stored raw at `offset` so they can be mapped directly.
+struct RegionSlot {
+    uint32_t offset;
+    uint16_t width;
+    uint16_t height;
+    uint8_t flags;
+    uint8_t fill;
+    uint16_t padding;
+};
+
+const size_t SLOT_TABLE_OFFSET = sizeof(RegionHeader);
+const size_t DATA_OFFSET = SLOT_TABLE_OFFSET + sizeof(RegionSlot) * SLOTS_PER_REGION;
+
+}
+
+struct ChunkStore::RegionFile {
+    int fd = -1;
+    RegionSlot slots[SLOTS_PER_REGION];
+    std::shared_ptr<const void> mapping;
+    size_t mappedSize = 0;
+
+    ~RegionFile() {
+        if (fd >= 0) close(fd);
+    }
+
+    // Maps the whole file, replacing the old mapping if the file has grown.
+    // Chunks still viewing the old mapping keep it alive until they go away.
+    bool ensureMapped(size_t requiredSize) {
+        if (mapping && mappedSize >= requiredSize) return true;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < requiredSize) return false;
+
+        size_t size = static_cast<size_t>(info.st_size);
+        void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) return false;
+
+        mapping = std::shared_ptr<const void>(address, [size](const void* p) {
+            munmap(const_cast<void*>(p), size);
+        });
+        mappedSize = size;
+        return true;
+    }
+};
+
+ChunkStore::ChunkStore(const std::string& directory, size_t maxResidentChunks, int chunkSize, uint64_t sourceHash)
+    : directory(directory), maxResidentChunks(maxResidentChunks), chunkSize(chunkSize), sourceHash(sourceHash),
+      nextVersion(0), terminateFlusher(false) {
+    if (!directory.empty()) {
+        if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            std::cerr << "Failed to create chunk region directory " << directory << ": " << strerror(errno) << std::endl;
+            this->directory.clear();
+        }
+    }
+    flusher = std::thread(&ChunkStore::flusherThread, this);
+}
+
+ChunkStore::~ChunkStore() {
+    {
+        // Persist everything still resident so the next session can page it back in
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (!directory.empty()) {
+            for (const auto& resident : lru) {
+                if (resident.dirty) {
+                    pendingWrites[resident.key] = {resident.chunk, nextVersion++};
+                }
+            }
+        }
+        lru.clear();
+        residentChunks.clear();
+        terminateFlusher = true;
+    }
+    flushCv.notify_one();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+}
+
+ChunkStore::ChunkKey ChunkStore::makeKey(int chunkX, int chunkY) {
+    return (static_cast<ChunkKey>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+}
+
+int ChunkStore::floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+void ChunkStore::store(int chunkX, int chunkY, const Chunk& chunk) {
+    ChunkKey key = makeKey(chunkX, chunkY);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto existing = residentChunks.find(key);
+    if (existing != residentChunks.end()) {
+        lru.erase(existing->second);
+        residentChunks.erase(existing);
+    }
+
+    // Only a chunk viewing its region file unchanged has nothing to write back
+    lru.push_front({key, chunk, !chunk.isView() || chunk.isModified()});
+    residentChunks[key] = lru.begin();
+
+    evictOverBudget();
+}
+
+bool ChunkStore::load(int chunkX, int chunkY, Chunk& out) {
+    ChunkKey key = makeKey(chunkX, chunkY);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto resident = residentChunks.find(key);
+        if (resident != residentChunks.end()) {
+            out = resident->second->chunk;
+            lru.erase(resident->second);
+            residentChunks.erase(resident);
+            return true;
+        }
+
+        auto pending = pendingWrites.find(key);
+        if (pending != pendingWrites.end()) {
+            out = pending->second.chunk;
+            return true;
+        }
+    }
+
+    if (directory.empty()) return false;
+    return readChunk(chunkX, chunkY, out);
+}
+
+void ChunkStore::flush() {
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    flushCv.notify_one();
+    flushedCv.wait(lock, [this] { return pendingWrites.empty(); });
+}
+
+size_t ChunkStore::getResidentCount() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return lru.size();
+}
+
+void ChunkStore::evictOverBudget() {
+    if (directory.empty()) return;
+
+    bool queued = false;
+    while (lru.size() > maxResidentChunks) {
+        ResidentChunk& oldest = lru.back();
+        if (oldest.dirty) {
+            pendingWrites[oldest.key] = {oldest.chunk, nextVersion++};
+            queued = true;
+        }
+        residentChunks.erase(oldest.key);
+        lru.pop_back();
+    }
+
+    if (queued) {
+        flushCv.notify_one();
+    }
+}
+
+void ChunkStore::flusherThread() {
+    Profiler::setThreadName("Chunk flusher");
+    std::vector<std::pair<ChunkKey, PendingWrite>> batch;
+
+    while (true) {
+        std::unique_lock<std::mutex> lock(cacheMutex);
+        flushCv.wait(lock, [this] { return terminateFlusher || !pendingWrites.empty(); });
+        if (pendingWrites.empty() && terminateFlusher) break;
+
+        batch.assign(pendingWrites.begin(), pendingWrites.end());
+        lock.unlock();
+
+        // Write outside the cache lock so the game thread can keep storing/loading
+        PROFILE_ZONE("ChunkStore::flush");
+        for (const auto& [key, write] : batch) {
+            int chunkX = static_cast<int>(static_cast<uint32_t>(key >> 32));
+            int chunkY = static_cast<int>(static_cast<uint32_t>(key & 0xffffffff));
+            if (!writeChunk(chunkX, chunkY, write.chunk)) {
+                std::cerr << "Failed to write chunk " << chunkX << "," << chunkY << " to region file" << std::endl;
+            }
+        }
+
+        lock.lock();
+        for (const auto& [key, write] : batch) {
+            auto pending = pendingWrites.find(key);
+            if (pending != pendingWrites.end() && pending->second.version == write.version) {
+                pendingWrites.erase(pending);
+            }
+        }
+        batch.clear();
+        flushedCv.notify_all();
+    }
+}
+
+std::string ChunkStore::getRegionPath(int regionX, int regionY) const {
+    return directory + "/r." + std::to_string(regionX) + "." + std::to_string(regionY) + ".region";
+}
+
+std::shared_ptr<ChunkStore::RegionFile> ChunkStore::openRegion(int regionX, int regionY, bool create) {
+    ChunkKey regionKey = makeKey(regionX, regionY);
+    auto it = regions.find(regionKey);
+    if (it != regions.end()) return it->second;
+
+    std::string path = getRegionPath(regionX, regionY);
+    int fd = open(path.c_str(), create ? (O_RDWR | O_CREAT) : O_RDWR, 0644);
+    if (fd < 0) return nullptr;
+
+    auto region = std::make_shared<RegionFile>();
+    region->fd = fd;
+
+    RegionHeader header;
+    bool valid = pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                 std::memcmp(header.magic, REGION_MAGIC, sizeof(REGION_MAGIC)) == 0 &&
+                 header.version == REGION_VERSION && header.slotCount == SLOTS_PER_REGION &&
+                 header.chunkSize == static_cast<uint32_t>(chunkSize) && header.sourceHash == sourceHash &&
+                 pread(fd, region->slots, sizeof(region->slots), SLOT_TABLE_OFFSET) == static_cast<ssize_t>(sizeof(region->slots));
+
+    if (!valid) {
+        // Written for another map or chunk size (or unreadable): its tiles would
+        // disagree with the map collision reads, so drop it
+        if (!create) {
+            unlink(path.c_str());
+            return nullptr;
+        }
+
+        // New (or unreadable) region: start over with an empty slot table
+        std::memcpy(header.magic, REGION_MAGIC, sizeof(REGION_MAGIC));
+        header.version = REGION_VERSION;
+        header.slotCount = SLOTS_PER_REGION;
+        header.chunkSize = static_cast<uint32_t>(chunkSize);
+        header.sourceHash = sourceHash;
+        std::memset(region->slots, 0, sizeof(region->slots));
+
+        if (ftruncate(fd, 0) != 0 ||
+            pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            pwrite(fd, region->slots, sizeof(region->slots), SLOT_TABLE_OFFSET) != static_cast<ssize_t>(sizeof(region->slots))) {
+            return nullptr;
+        }
+    }
+
+    regions[regionKey] = region;
+    return region;
+}
+
+bool ChunkStore::writeChunk(int chunkX, int chunkY, const Chunk& chunk) {
+    int regionX = floorDiv(chunkX, REGION_SIZE);
+    int regionY = floorDiv(chunkY, REGION_SIZE);
+    int slotIndex = (chunkY - regionY * REGION_SIZE) * REGION_SIZE + (chunkX - regionX * REGION_SIZE);
+
+    std::lock_guard<std::mutex> lock(regionMutex);
+    auto region = openRegion(regionX, regionY, true);
+    if (!region) return false;
+
+    RegionSlot slot = region->slots[slotIndex];
+    size_t size = static_cast<size_t>(chunk.getWidth()) * chunk.getHeight();
+
+    if (chunk.isUniform()) {
+        slot.flags = SLOT_PRESENT | SLOT_UNIFORM;
+        slot.fill = chunk.getFill();
+    } else {
+        // Chunks keep their dimensions, so a slot is normally rewritten in place
+        bool reuse = (slot.flags & SLOT_PRESENT) && !(slot.flags & SLOT_UNIFORM) &&
+                     static_cast<size_t>(slot.width) * slot.height == size;
+        if (!reuse) {
+            struct stat info;
+            if (fstat(region->fd, &info) != 0) return false;
+            slot.offset = static_cast<uint32_t>(std::max(static_cast<size_t>(info.st_size), DATA_OFFSET));
+        }
+
+        if (pwrite(region->fd, chunk.data(), size, slot.offset) != static_cast<ssize_t>(size)) return false;
+        slot.flags = SLOT_PRESENT;
+        slot.fill = 0;
+    }
+    slot.width = static_cast<uint16_t>(chunk.getWidth());
+    slot.height = static_cast<uint16_t>(chunk.getHeight());
+
+    if (pwrite(region->fd, &slot, sizeof(slot), SLOT_TABLE_OFFSET + sizeof(RegionSlot) * slotIndex) != static_cast<ssize_t>(sizeof(slot))) {
+        return false;
+    }
+    region->slots[slotIndex] = slot;
+    return true;
+}
+
+bool ChunkStore::readChunk(int chunkX, int chunkY, Chunk& out) {
+    int regionX = floorDiv(chunkX, REGION_SIZE);
+    int regionY = floorDiv(chunkY, REGION_SIZE);
+    int slotIndex = (chunkY - regionY * REGION_SIZE) * REGION_SIZE + (chunkX - regionX * REGION_SIZE);
+
+    std::lock_guard<std::mutex> lock(regionMutex);
+    auto region = openRegion(regionX, regionY, false);
+    if (!region) return false;
+
+    const RegionSlot& slot = region->slots[slotIndex];
+    if (!(slot.flags & SLOT_PRESENT)) return false;
+
+    if (slot.flags & SLOT_UNIFORM) {
+        out = Chunk(slot.width, slot.height, slot.fill);
+        return true;
+    }
+
+    size_t size = static_cast<size_t>(slot.width) * slot.height;
+    if (!region->ensureMapped(slot.offset + size)) return false;
+
+    const uint8_t* base = static_cast<const uint8_t*>(region->mapping.get());
+    out = Chunk::fromView(slot.width, slot.height, base + slot.offset, region->mapping);
+    return true;
+}
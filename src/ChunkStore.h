@@ -0,0 +1,95 @@
+#ifndef CHUNKSTORE_H
+#define CHUNKSTORE_H
+
+#include "Chunk.h"
+#include <cstdint>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Keeps chunks that have left the active window.
+// Recently unloaded chunks stay in memory up to a residency budget (LRU).
+// Past the budget they are written by a background thread into region files
+// (REGION_SIZE x REGION_SIZE chunks per file), which are read back through
+// mmap so a revisited chunk points straight into the mapped file.
+// Every evicted chunk is written unless it is an unmodified view of its
+// region file already, so a revisit pages it back in instead of rebuilding
+// it from the source map. Region files record the chunk size and a hash of
+// the source map and are discarded when either changes.
+class ChunkStore {
+public:
+    static const int REGION_SIZE = 6;
+
+    // An empty directory keeps everything in memory and never evicts.
+    ChunkStore(const std::string& directory, size_t maxResidentChunks, int chunkSize, uint64_t sourceHash);
+    ~ChunkStore();
+
+    ChunkStore(const ChunkStore&) = delete;
+    ChunkStore& operator=(const ChunkStore&) = delete;
+
+    // Hands a chunk that is leaving the active window over to the store
+    void store(int chunkX, int chunkY, const Chunk& chunk);
+
+    // Takes a previously stored chunk back. Returns false if it was never stored.
+    bool load(int chunkX, int chunkY, Chunk& out);
+
+    // Blocks until every evicted chunk has been written to disk
+    void flush();
+
+    size_t getResidentCount();
+
+private:
+    using ChunkKey = unsigned long long;
+
+    struct RegionFile;
+
+    struct ResidentChunk {
+        ChunkKey key;
+        Chunk chunk;
+        bool dirty;  // Differs from its region file, or was never written to one
+    };
+
+    struct PendingWrite {
+        Chunk chunk;
+        unsigned long long version;
+    };
+
+    static ChunkKey makeKey(int chunkX, int chunkY);
+    static int floorDiv(int value, int divisor);
+
+    void flusherThread();
+    void evictOverBudget();
+    bool writeChunk(int chunkX, int chunkY, const Chunk& chunk);
+    bool readChunk(int chunkX, int chunkY, Chunk& out);
+    std::shared_ptr<RegionFile> openRegion(int regionX, int regionY, bool create);
+    std::string getRegionPath(int regionX, int regionY) const;
+
+    std::string directory;
+    size_t maxResidentChunks;
+    int chunkSize;
+    uint64_t sourceHash;
+
+    // Resident chunks, most recently stored at the front
+    std::mutex cacheMutex;
+    std::list<ResidentChunk> lru;
+    std::unordered_map<ChunkKey, std::list<ResidentChunk>::iterator> residentChunks;
+
+    // Chunks evicted from the LRU that the flusher has not written yet
+    std::unordered_map<ChunkKey, PendingWrite> pendingWrites;
+    unsigned long long nextVersion;
+    std::condition_variable flushCv;
+    std::condition_variable flushedCv;
+    bool terminateFlusher;
+
+    // Open region files, guarded separately so disk I/O does not block the cache
+    std::mutex regionMutex;
+    std::unordered_map<ChunkKey, std::shared_ptr<RegionFile>> regions;
+
+    std::thread flusher;
+};
+
+#endif // CHUNKSTORE_H
@@ -0,0 +1,32 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <cstdint>
+
+// Anything that can stand in for simulation time, e.g. a test driving
+// entities through exact timer boundaries
+class ClockSource {
+public:
+    virtual ~ClockSource() = default;
+    virtual uint32_t getTicks() const = 0;
+};
+
+// Simulation time, advanced only by fixed simulation steps.
+// Gameplay timers (attack delays, spell lifetimes, path refreshes) read this
+// instead of SDL_GetTicks, so a step behaves the same no matter how late it
+// runs or how many steps a slow frame has to catch up on.
+// An installed ClockSource replaces the step clock until it is removed.
+class SimulationClock {
+public:
+    static uint32_t getTicks() { return source ? source->getTicks() : static_cast<uint32_t>(elapsedMs); }
+    static void advance(float seconds) { elapsedMs += seconds * 1000.0; }
+    static void reset() { elapsedMs = 0.0; }
+
+    static void setSource(const ClockSource* clock) { source = clock; }   // nullptr restores the step clock
+
+private:
+    static inline double elapsedMs = 0.0;
+    static inline const ClockSource* source = nullptr;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "Collision.h"
+#include "Enemy.h"
+#include "Player.h"
+#include "Clock.h"
+#include "Profiler.h"
+#include <cstdlib>
+
+void resolvePlayerEnemyCollisions(Player& player, SlotMap<Enemy>& enemies, SimulationContext& context) {
+    PROFILE_ZONE("Collision");
+    for (auto& enemy : enemies) {
+        if (enemy.isMarkedForRemoval()) continue;
+
+        if (Entity::checkCollision(player.getBoundingBox(), enemy.getBoundingBox())) {
+            resolveCollision(player, enemy, context);
+        }
+    }
+}
+
+void resolveCollision(Player& player, Enemy& enemy, SimulationContext& context) {
+    Rect playerBox = player.getBoundingBox();
+    Rect enemyBox = enemy.getBoundingBox();
+
+    if (Entity::checkCollision(playerBox, enemyBox)) {
+        adjustPositionOnCollision(player, enemy);
+    }
+
+    Rect playerAttackBox = player.getAttackBoundingBox();
+    Rect enemyAttackBox = enemy.getAttackBoundingBox();
+
+    uint32_t currentTime = SimulationClock::getTicks();
+
+    // Check player's attack collision with enemy
+    if (Entity::checkCollision(playerAttackBox, enemy.getBoundingBox())) {
+        if (player.getAction() == Entity::Thrusting && !player.getDamageApplied() && (currentTime - player.getAttackStartTime() >= player.getAttackDelay())) {
+            context.applyDamage(player, enemy, Player::THRUST_DAMAGE);
+            player.setDamageApplied(true);
+        } else if (player.getAction() == Entity::Slashing && !player.getDamageApplied() && (currentTime - player.getAttackStartTime() >= player.getAttackDelay())) {
+            context.applyDamage(player, enemy, Player::SLASH_DAMAGE);
+            player.setDamageApplied(true);
+        }
+    }
+
+    // Check enemy's attack collision with player
+    if (Entity::checkCollision(enemyAttackBox, player.getBoundingBox())) {
+        if (enemy.getAction() == Entity::Thrusting && !enemy.getDamageApplied() && (currentTime - enemy.getAttackStartTime() >= enemy.getAttackDelay())) {
+            context.applyDamage(enemy, player, enemy.getThrustDamage());
+            enemy.setDamageApplied(true);
+        } else if (enemy.getAction() == Entity::Spellcasting && !enemy.getDamageApplied() && (currentTime - enemy.getAttackStartTime() >= enemy.getAttackDelay())) {
+            context.applyDamage(enemy, player, enemy.getSpellDamage());
+            enemy.setDamageApplied(true);
+        }
+    }
+}
+
+void adjustPositionOnCollision(Player& player, Enemy& enemy) {
+    Rect playerBox = player.getCollisionBoundingBox();
+    Rect enemyBox = enemy.getCollisionBoundingBox();
+
+    // Calculate the overlap between the player and the enemy
+    int overlapX = (playerBox.x + playerBox.w / 2) - (enemyBox.x + enemyBox.w / 2);
+    int overlapY = (playerBox.y + playerBox.h / 2) - (enemyBox.y + enemyBox.h / 2);
+
+    int halfWidth = (playerBox.w + enemyBox.w) / 2;
+    int halfHeight = (playerBox.h + enemyBox.h) / 2;
+
+    if (abs(overlapX) < halfWidth && abs(overlapY) < halfHeight) {
+        int offsetX = halfWidth - abs(overlapX);
+        int offsetY = halfHeight - abs(overlapY);
+
+        // Resolve collision by adjusting positions based on the overlap amount
+        if (offsetX < offsetY) {
+            if (overlapX > 0) {
+                player.setX(player.getX() + offsetX);
+                enemy.setX(enemy.getX() - offsetX);
+            } else {
+                player.setX(player.getX() - offsetX);
+                enemy.setX(enemy.getX() + offsetX);
+            }
+        } else {
+            if (overlapY > 0) {
+                player.setY(player.getY() + offsetY);
+                enemy.setY(enemy.getY() - offsetY);
+            } else {
+                player.setY(player.getY() - offsetY);
+                enemy.setY(enemy.getY() + offsetY);
+            }
+        }
+    }
+}
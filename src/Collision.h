@@ -0,0 +1,22 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "SlotMap.h"
+
+class Player;
+class Enemy;
+class SimulationContext;
+
+// Melee contact between the player and the enemies, as Game::step runs it.
+// Overlapping bodies are pushed apart and attacks that have wound up land
+// through the context's applyDamage.
+
+// Checks the player against every live enemy
+void resolvePlayerEnemyCollisions(Player& player, SlotMap<Enemy>& enemies, SimulationContext& context);
+
+void resolveCollision(Player& player, Enemy& enemy, SimulationContext& context);
+
+// Moves both apart along the axis of least overlap
+void adjustPositionOnCollision(Player& player, Enemy& enemy);
+
+#endif
@@ -0,0 +1,46 @@
+#include "EllerMaze.h"
+
+EllerMaze::EllerMaze(int p_columns, Random& p_rng)
+    : columns(p_columns), rng(p_rng), left(p_columns), right(p_columns) {
+    for (int c = 0; c < columns; ++c) {
+        left[c] = c;
+        right[c] = c;
+    }
+}
+
+void EllerMaze::nextRow(int* cellRow, int* wallRow, bool last) {
+    int gridWidth = getGridWidth();
+    for (int x = 0; x < gridWidth; ++x) {
+        cellRow[x] = -1;
+        wallRow[x] = -1;
+    }
+
+    for (int c = 0; c < columns; ++c) {
+        cellRow[2 * c + 1] = 0;
+
+        // Sets never cross, so c and c + 1 share a set exactly when c + 1
+        // follows c in it. Otherwise splice c + 1's set in after c.
+        if (c + 1 < columns && right[c] != c + 1 && (last || (rng.next() & 1))) {
+            left[right[c]] = left[c + 1];
+            right[left[c + 1]] = right[c];
+            right[c] = c + 1;
+            left[c + 1] = c;
+            cellRow[2 * c + 2] = 0;
+        }
+    }
+
+    if (last) return;
+
+    for (int c = 0; c < columns; ++c) {
+        // A cell may stay closed below only if its set goes down elsewhere;
+        // it then starts a set of its own in the next row
+        if (right[c] != c && (rng.next() & 1)) {
+            left[right[c]] = left[c];
+            right[left[c]] = right[c];
+            left[c] = c;
+            right[c] = c;
+        } else {
+            wallRow[2 * c + 1] = 0;
+        }
+    }
+}
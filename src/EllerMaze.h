@@ -0,0 +1,31 @@
+#ifndef ELLERMAZE_H
+#define ELLERMAZE_H
+
+#include <vector>
+#include "Random.h"
+
+// Eller's algorithm, one row of cells at a time. Only the current row's sets
+// are kept, as circular linked lists of columns, so a maze of any height
+// streams out in O(width) memory.
+// Output rows use the dungeon maze format: -1 walls, 0 paths, cells on odd
+// columns, with a wall column at either edge.
+class EllerMaze {
+public:
+    EllerMaze(int columns, Random& rng);
+
+    int getColumns() const { return columns; }
+    int getGridWidth() const { return 2 * columns + 1; }
+
+    // Writes the next row of cells and the wall row below it, getGridWidth()
+    // entries each. The last row joins every remaining set and closes the
+    // bottom, so the rows emitted so far form a perfect maze.
+    void nextRow(int* cellRow, int* wallRow, bool last = false);
+
+private:
+    int columns;
+    Random& rng;
+    std::vector<int> left;      // Previous and next column in the same set,
+    std::vector<int> right;     // in circular column order
+};
+
+#endif
@@ -0,0 +1,30 @@
+#include "EndlessMaze.h"
+#include <algorithm>
+
+EndlessMaze::EndlessMaze(int columns, int p_windowCellRows, uint64_t seed)
+    : windowCellRows(p_windowCellRows), originRow(0), rng(seed), eller(columns, rng) {}
+
+void EndlessMaze::start(Grid<int>& window) {
+    window.assign(eller.getGridWidth(), 2 * windowCellRows + 1, -1);
+    for (int r = 0; r < windowCellRows; ++r) {
+        eller.nextRow(window[2 * r + 1], window[2 * r + 2]);
+    }
+    originRow = 0;
+}
+
+int EndlessMaze::scroll(Grid<int>& window, int cellRows) {
+    cellRows = std::min(cellRows, windowCellRows);
+    int shift = 2 * cellRows;
+
+    // Rows move in cell/wall pairs, so window row 0 stays a wall row
+    std::copy(window[shift], window.data() + window.size(), window[0]);
+    for (int r = windowCellRows - cellRows; r < windowCellRows; ++r) {
+        eller.nextRow(window[2 * r + 1], window[2 * r + 2]);
+    }
+
+    // Passages up into the dropped rows lead nowhere now
+    std::fill(window[0], window[0] + window.getWidth(), -1);
+
+    originRow += shift;
+    return shift;
+}
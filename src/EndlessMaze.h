@@ -0,0 +1,40 @@
+#ifndef ENDLESSMAZE_H
+#define ENDLESSMAZE_H
+
+#include <cstdint>
+#include "EllerMaze.h"
+#include "Grid.h"
+#include "Random.h"
+
+// A dungeon maze with no bottom. Only a fixed window of rows exists at any
+// time: as the player descends, rows are dropped off the top and Eller's
+// algorithm streams new ones in below, so memory is the same at any depth.
+// The window is an ordinary maze grid to everything that reads it; the game
+// moves its entities up by each scroll (a floating origin) so coordinates
+// stay small however deep the player goes.
+class EndlessMaze {
+public:
+    EndlessMaze(int columns, int windowCellRows, uint64_t seed);
+
+    EndlessMaze(const EndlessMaze&) = delete;
+    EndlessMaze& operator=(const EndlessMaze&) = delete;
+
+    // Fills `window` with the first rows of the maze, top edge closed. Called once.
+    void start(Grid<int>& window);
+
+    // Drops `cellRows` rows of cells off the top of `window` and streams as
+    // many new ones in at the bottom. Returns how many grid rows the window's
+    // content moved up, which the caller subtracts from everything it placed.
+    int scroll(Grid<int>& window, int cellRows);
+
+    int64_t getOriginRow() const { return originRow; }  // Maze row at the top of the window
+    int getWindowCellRows() const { return windowCellRows; }
+
+private:
+    int windowCellRows;
+    int64_t originRow;
+    Random rng;
+    EllerMaze eller;    // Draws from rng, so declared after it
+};
+
+#endif
@@ -1,9 +1,12 @@
 #include "Enemy.h"
+#include "Clock.h"
+#include "Profiler.h"
 #include <iostream>
 #include <queue>
 #include <unordered_map>
 #include <algorithm>
 #include "PathfindingManager.h"
+#include "Pathfinding.h"
 
 const float Enemy::SPELL_COOLDOWN = 10.0f;
 
@@ -12,14 +15,14 @@ const int ENEMY_PADDING_Y = 56;
 
 const int CELL_SIZE = 96;
 
-Enemy::Enemy(float p_x, float p_y, SDL_Texture* p_tex, int numFrames, float animationSpeed, PathfindingManager& pathfindingManager)
-    : Entity(p_x, p_y, p_tex, numFrames, animationSpeed),
-      pathfindingManager(pathfindingManager),
+Enemy::Enemy(EntityStates& states, float p_x, float p_y, SpriteSheetId p_sheet, int numFrames, float animationSpeed, PathfindingManager& pathfindingManager)
+    : Entity(states, EnemyEntity, p_x, p_y, p_sheet, numFrames, animationSpeed),
+      pathfindingManager(&pathfindingManager),
       lastSharedPathUpdateTime(0),
+      sharedPathUpdatePhase(pathfindingManager.nextRefreshPhase(sharedPathUpdateInterval)),
       lastPlayerCellX(-1),
       lastPlayerCellY(-1),
       currentPathIndex(0),
-      bounceCount(0),
       attackCooldown(0.0f), 
       spellRange(300.0f), 
       thrustRange(100.0f), 
@@ -27,11 +30,7 @@ Enemy::Enemy(float p_x, float p_y, SDL_Texture* p_tex, int numFrames, float anim
       timeSinceLastDirectionChange(0.0f), 
       hasTarget(false), 
       hasPath(false),
-      spellDirX(0.0f),
-      spellDirY(0.0f),
-      spellState(CURVED_TRAJECTORY),
-      lastBounceTime(0),
-      bounceDistance(0.0f)
+      spellCooldownRemaining(0.0f)
 {
     // Initialize stats based on difficulty (default values; will be overridden)
     maxHealth = INITIAL_HEALTH;
@@ -53,155 +52,32 @@ int Enemy::getThrustDamage() const { return thrustDamage; }
 void Enemy::setSpellDamage(int damage) { spellDamage = damage; }
 int Enemy::getSpellDamage() const { return spellDamage; }
 
-void Enemy::setSpellTarget(float targetX, float targetY) {
-    spellActive = true;
-    spellX = x + FRAME_WIDTH / 2;
-    spellY = y - 10;
-    spellTargetX = targetX;
-    spellTargetY = targetY;
-    spellStartTime = SDL_GetTicks();
-    spellDuration = SPELL_DURATION;
-    spellSpeed = 100.0f;
-    setAction(Spellcasting);
-    spellCooldownRemaining = SPELL_COOLDOWN;
-}
-
-void Enemy::updateSpellPosition(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities, Game& game) {
-    if (!spellActive) {
-        return;
-    }
-
-    Uint32 currentTime = SDL_GetTicks();
-
-    if (currentTime - spellStartTime > spellDuration) {
-        deactivateSpell();
-        return;
-    }
-
-    const float wallPadding = 5.0f;
-
-    if (spellState == BOUNCING && currentTime - lastBounceTime > 2000) {
-        spellState = CURVED_TRAJECTORY;
-    }
-
-    if (spellState == CURVED_TRAJECTORY) {
-        Player* closestPlayer = nullptr;
-        float minDistance = std::numeric_limits<float>::max();
-        for (const auto& entity : entities) {
-            if (Player* player = dynamic_cast<Player*>(entity.get())) {
-                if (!player->getIsDead()) {
-                    float distance = std::hypot(spellX - player->getX(), spellY - player->getY());
-                    if (distance < minDistance) {
-                        minDistance = distance;
-                        closestPlayer = player;
-                    }
-                }
-            }
-        }
-        if (closestPlayer) {
-            spellTargetX = closestPlayer->getX();
-            spellTargetY = closestPlayer->getY();
-        } else {
-            deactivateSpell();
-            return;
-        }
-
-        float dx = spellTargetX - spellX;
-        float dy = spellTargetY - spellY;
-        float distance = std::hypot(dx, dy);
-
-        if (distance > 5.0f) {
-            float curve = sin(SDL_GetTicks() * 0.001f);
-
-            float controlPointX = (spellX + spellTargetX) / 2 + curve * 50;
-            float controlPointY = (spellY + spellTargetY) / 2 + curve * 50;
-
-            float t = spellSpeed * deltaTime / distance;
-            spellX = (1 - t) * (1 - t) * spellX + 2 * (1 - t) * t * controlPointX + t * t * spellTargetX;
-            spellY = (1 - t) * (1 - t) * spellY + 2 * (1 - t) * t * controlPointY + t * t * spellTargetY;
-
-            if (isSpellCollidingWithWall(spellX + spellDirX * wallPadding, spellY + spellDirY * wallPadding, 96, game.getDungeonMaze())) {
-                spellState = BOUNCING;
-                lastBounceTime = currentTime;
-                bounceDistance = 0.0f;
-
-                float directionDx = spellTargetX - spellX;
-                float directionDy = spellTargetY - spellY;
-                float directionDistance = std::hypot(directionDx, directionDy);
-
-                if (directionDistance > 0) {
-                    spellDirX = directionDx / directionDistance;
-                    spellDirY = directionDy / directionDistance;
-                }
-            }
-        } else {
-            deactivateSpell();
-            return;
-        }
-    } else if (spellState == BOUNCING) {
-        float newSpellX = spellX + spellDirX * spellSpeed * deltaTime;
-        float newSpellY = spellY + spellDirY * spellSpeed * deltaTime;
-
-        bounceDistance += std::hypot(newSpellX - spellX, newSpellY - spellY);
-
-        if (isSpellCollidingWithWall(newSpellX + spellDirX * wallPadding, newSpellY + spellDirY * wallPadding, 96, game.getDungeonMaze())) {
-            if (isSpellCollidingWithWall(newSpellX + spellDirX * wallPadding, spellY, 96, game.getDungeonMaze())) {
-                spellDirX = -spellDirX;
-            }
-            if (isSpellCollidingWithWall(spellX, newSpellY + spellDirY * wallPadding, 96, game.getDungeonMaze())) {
-                spellDirY = -spellDirY;
-            }
-
-            newSpellX = spellX + spellDirX * spellSpeed * deltaTime;
-            newSpellY = spellY + spellDirY * spellSpeed * deltaTime;
-
-            bounceCount++;
-            lastBounceTime = currentTime;
-            bounceDistance = 0.0f;
-
-            if (bounceCount >= 10) {
-                deactivateSpell();
-                return;
-            }
-        }
-
-        spellX = newSpellX;
-        spellY = newSpellY;
-    }
-
-    SDL_Rect spellRect = { static_cast<int>(spellX), static_cast<int>(spellY), FRAME_WIDTH - 40, FRAME_HEIGHT - 40 };
-    for (auto& entity : entities) {
-        if (Player* player = dynamic_cast<Player*>(entity.get())) {
-            if (!player->getIsDead()) {
-                SDL_Rect playerBoundingBox = player->getBoundingBox();
-                if (SDL_HasIntersection(&spellRect, &playerBoundingBox)) {
-                    player->takeDamage(spellDamage);
-                    if (!player->isAlive()) {
-                        player->setIsDead(true);
-                    }
+void Enemy::shiftPath(int dx, int dy) {
+    if (!pathToPlayer) return;
 
-                    deactivateSpell();
-                    return;
-                }
-            }
-        }
+    // Other enemies may share the path; shift a copy of our own
+    auto shifted = std::make_shared<std::vector<std::pair<int, int>>>(*pathToPlayer);
+    for (auto& waypoint : *shifted) {
+        waypoint.first += dx;
+        waypoint.second += dy;
     }
+    pathToPlayer = std::move(shifted);
 }
 
-void Enemy::followSharedPath(float deltaTime, Player& player, Game& game) {
-    if (isMarkedForRemoval() || !hasPath || pathToPlayer.empty()) return;
+void Enemy::followSharedPath(float deltaTime, Player& player, SimulationContext& context) {
+    if (isMarkedForRemoval() || !hasPath || !pathToPlayer || pathToPlayer->empty()) return;
 
-    moveToNextWaypoint(deltaTime, player, game);
+    moveToNextWaypoint(deltaTime, player, context);
 }
 
-std::vector<std::pair<int, int>> Enemy::calculateNewPath(Player& player, Game& game) {
-    return findPathToPlayer(player, game);
+std::vector<std::pair<int, int>> Enemy::calculateNewPath(Player& player, SimulationContext& context) {
+    return findPathToPlayer(player, context);
 }
 
-void Enemy::moveToNextWaypoint(float deltaTime, Player& player, Game& game) {
-    if (isMarkedForRemoval() || !hasPath || pathToPlayer.empty()) return;
+void Enemy::moveToNextWaypoint(float deltaTime, Player& player, SimulationContext& context) {
+    if (isMarkedForRemoval() || !hasPath || !pathToPlayer || pathToPlayer->empty()) return;
 
-    if (currentPathIndex >= pathToPlayer.size()) {
+    if (currentPathIndex >= pathToPlayer->size()) {
         hasPath = false;  // Mark path as complete
         return;
     }
@@ -209,7 +85,7 @@ void Enemy::moveToNextWaypoint(float deltaTime, Player& player, Game& game) {
     float moveSpeed = this->moveSpeed;
     bool moved = false;
 
-    auto [nextX, nextY] = pathToPlayer[currentPathIndex];
+    auto [nextX, nextY] = (*pathToPlayer)[currentPathIndex];
     
     // Adjust target positions to include padding
     float targetX = nextX * CELL_SIZE - ENEMY_PADDING_X;
@@ -240,10 +116,10 @@ void Enemy::moveToNextWaypoint(float deltaTime, Player& player, Game& game) {
     }
 
     // Check collision at all four corners of the enemy's bounding box
-    if (!game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
-        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
-        !game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+    if (!context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
+        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
+        !context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
         setX(newX);
         setY(newY);
         moved = true;
@@ -258,7 +134,7 @@ void Enemy::moveToNextWaypoint(float deltaTime, Player& player, Game& game) {
     }
 }
 
-void Enemy::updateBehavior(float deltaTime, Player& player, std::vector<std::unique_ptr<Entity>>& entities, Game& game) {
+void Enemy::updateBehavior(float deltaTime, Player& player, SimulationContext& context) {
     if (isMarkedForRemoval()) return;
 
     float distanceX = player.getX() - getX();
@@ -273,36 +149,46 @@ void Enemy::updateBehavior(float deltaTime, Player& player, std::vector<std::uni
         attackCooldown -= deltaTime;
     }
 
-    Uint32 currentTime = SDL_GetTicks();
+    uint32_t currentTime = SimulationClock::getTicks();
 
-    if (currentTime - lastSharedPathUpdateTime > sharedPathUpdateInterval) {
-        pathToPlayer = pathfindingManager.getSharedPathToPlayer(player, game, *this);
-        currentPathIndex = 0;
+    // The first path is fetched straight away, after which each enemy keeps
+    // to its own phase of the interval, so a wave of enemies spawned together
+    // spreads its refreshes over the steps instead of stalling one of them
+    if (!pathToPlayer) {
+        refreshSharedPath(player, context);
+        lastSharedPathUpdateTime = currentTime - sharedPathUpdatePhase;
+    } else if (currentTime - lastSharedPathUpdateTime > sharedPathUpdateInterval) {
+        refreshSharedPath(player, context);
         lastSharedPathUpdateTime = currentTime;
-        hasPath = !pathToPlayer.empty();
     }
 
     if (distance <= 150.0f) {
         // If close enough, move directly to the player
-        moveDirectlyToPlayer(deltaTime, player, game);
+        moveDirectlyToPlayer(deltaTime, player, context);
 
     } else if (distance <= 800.0f) {
         // If within a certain range, follow the shared path and possibly attack
         if (spellCooldownRemaining <= 0.0f) {
             decideAction(player, distance);
         }
-        followSharedPath(deltaTime, player, game);
+        followSharedPath(deltaTime, player, context);
 
     } else {
         // If far from the player, move randomly
-        randomMove(deltaTime, game);
+        randomMove(deltaTime, context);
         hasPath = false;
     }
 
-    updateEnemy(deltaTime, player, entities, game);
+    updateEnemy(deltaTime, player, context);
 }
 
-void Enemy::randomMove(float deltaTime, Game& game) {
+void Enemy::refreshSharedPath(Player& player, SimulationContext& context) {
+    pathToPlayer = pathfindingManager->getSharedPathToPlayer(player, context, *this);
+    currentPathIndex = 0;
+    hasPath = !pathToPlayer->empty();
+}
+
+void Enemy::randomMove(float deltaTime, SimulationContext& context) {
     float moveSpeed = this->moveSpeed;
     bool moved = false;
 
@@ -310,11 +196,8 @@ void Enemy::randomMove(float deltaTime, Game& game) {
 
     if (timeSinceLastDirectionChange >= directionChangeCooldown) {  // Check if cooldown has passed
         timeSinceLastDirectionChange = 0.0f;  // Reset timer
-        std::vector<Direction> directions = {Up, Down, Left, Right};
-
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(directions.begin(), directions.end(), g);
+        Direction directions[4] = {Up, Down, Left, Right};
+        RandomService::stream(RANDOM_AI).shuffle(directions, directions + 4);
 
         for (Direction dir : directions) {
             float newX = getX();
@@ -322,10 +205,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
             switch (dir) {
                 case Up:
                     newY -= moveSpeed * deltaTime;
-                    if (!game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
-                        !game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                    if (!context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
+                        !context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                         setY(newY);
                         setDirection(Up);
                         moved = true;
@@ -333,10 +216,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                     break;
                 case Down:
                     newY += moveSpeed * deltaTime;
-                    if (!game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
-                        !game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                    if (!context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
+                        !context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                         setY(newY);
                         setDirection(Down);
                         moved = true;
@@ -344,10 +227,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                     break;
                 case Left:
                     newX -= moveSpeed * deltaTime;
-                    if (!game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
-                        !game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                    if (!context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
+                        !context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                         setX(newX);
                         setDirection(Left);
                         moved = true;
@@ -355,10 +238,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                     break;
                 case Right:
                     newX += moveSpeed * deltaTime;
-                    if (!game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
-                        !game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                        !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                    if (!context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
+                        !context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                        !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                         setX(newX);
                         setDirection(Right);
                         moved = true;
@@ -373,10 +256,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
         // Continue moving in the same direction if not changed
         switch (getDirection()) {
             case Up:
-                if (!game.isWall(getX() + ENEMY_PADDING_X, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() + ENEMY_PADDING_X, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                    !game.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                if (!context.isWall(getX() + ENEMY_PADDING_X, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() + ENEMY_PADDING_X, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                    !context.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                     setY(getY() - moveSpeed * deltaTime);
                     moved = true;
                 } else {
@@ -384,10 +267,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                 }
                 break;
             case Down:
-                if (!game.isWall(getX() + ENEMY_PADDING_X, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() + ENEMY_PADDING_X, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                    !game.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                if (!context.isWall(getX() + ENEMY_PADDING_X, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() + ENEMY_PADDING_X, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                    !context.isWall(getX() + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                     setY(getY() + moveSpeed * deltaTime);
                     moved = true;
                 } else {
@@ -395,10 +278,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                 }
                 break;
             case Left:
-                if (!game.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                    !game.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                if (!context.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                    !context.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                     setX(getX() - moveSpeed * deltaTime);
                     moved = true;
                 } else {
@@ -406,10 +289,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                 }
                 break;
             case Right:
-                if (!game.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y) &&
-                    !game.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                    !game.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+                if (!context.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y) &&
+                    !context.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                    !context.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X + FRAME_WIDTH - 1, getY() + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                     setX(getX() + moveSpeed * deltaTime);
                     moved = true;
                 } else {
@@ -421,11 +304,8 @@ void Enemy::randomMove(float deltaTime, Game& game) {
 
     if (!moved) {
         // Choose a new direction where there is no wall
-        std::vector<Direction> directions = {Up, Down, Left, Right};
-
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(directions.begin(), directions.end(), g);
+        Direction directions[4] = {Up, Down, Left, Right};
+        RandomService::stream(RANDOM_AI).shuffle(directions, directions + 4);
 
         for (Direction dir : directions) {
             float newX = getX();
@@ -444,10 +324,10 @@ void Enemy::randomMove(float deltaTime, Game& game) {
                     newX += moveSpeed * deltaTime;
                     break;
             }
-            if (!game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
-                !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
-                !game.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
-                !game.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
+            if (!context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y) && 
+                !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y) &&
+                !context.isWall(newX + ENEMY_PADDING_X, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1) &&
+                !context.isWall(newX + ENEMY_PADDING_X + FRAME_WIDTH - 1, newY + ENEMY_PADDING_Y + FRAME_HEIGHT - 1)) {
                 setX(newX);
                 setY(newY);
                 setDirection(dir);
@@ -459,7 +339,7 @@ void Enemy::randomMove(float deltaTime, Game& game) {
     startAnimation();
 }
 
-void Enemy::moveDirectlyToPlayer(float deltaTime, Player& player, Game& game) {
+void Enemy::moveDirectlyToPlayer(float deltaTime, Player& player, SimulationContext& context) {
     if (isMarkedForRemoval()) return;
 
     float distanceX = player.getX() - getX();
@@ -482,13 +362,13 @@ void Enemy::moveDirectlyToPlayer(float deltaTime, Player& player, Game& game) {
 
         if (fabs(distanceX) > fabs(distanceY)) {
             if (distanceX > 0) {
-                if (!game.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y)) {
+                if (!context.isWall(getX() + moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y)) {
                     setX(getX() + moveSpeed * deltaTime);
                     moved = true;
                 }
                 setDirection(Right);
             } else {
-                if (!game.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y)) {
+                if (!context.isWall(getX() - moveSpeed * deltaTime + ENEMY_PADDING_X, getY() + ENEMY_PADDING_Y)) {
                     setX(getX() - moveSpeed * deltaTime);
                     moved = true;
                 }
@@ -496,13 +376,13 @@ void Enemy::moveDirectlyToPlayer(float deltaTime, Player& player, Game& game) {
             }
         } else {
             if (distanceY > 0) {
-                if (!game.isWall(getX() + ENEMY_PADDING_X, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y)) {
+                if (!context.isWall(getX() + ENEMY_PADDING_X, getY() + moveSpeed * deltaTime + ENEMY_PADDING_Y)) {
                     setY(getY() + moveSpeed * deltaTime);
                     moved = true;
                 }
                 setDirection(Down);
             } else {
-                if (!game.isWall(getX() + ENEMY_PADDING_X, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y)) {
+                if (!context.isWall(getX() + ENEMY_PADDING_X, getY() - moveSpeed * deltaTime + ENEMY_PADDING_Y)) {
                     setY(getY() - moveSpeed * deltaTime);
                     moved = true;
                 }
@@ -511,16 +391,16 @@ void Enemy::moveDirectlyToPlayer(float deltaTime, Player& player, Game& game) {
         }
 
         if (!moved) {
-            pathToPlayer = findPathToPlayer(player, game);
+            pathToPlayer = std::make_shared<const std::vector<std::pair<int, int>>>(findPathToPlayer(player, context));
             currentPathIndex = 0;
-            followSharedPath(deltaTime, player, game);
+            followSharedPath(deltaTime, player, context);
         }
     }
 
     startAnimation();
 }
 
-void Enemy::updateEnemy(float deltaTime, Player& player, std::vector<std::unique_ptr<Entity>>& entities, Game& game) {
+void Enemy::updateEnemy(float deltaTime, Player& player, SimulationContext& context) {
     if (isMarkedForRemoval()) return;
 
     float actualSpeed = isRunning() ? 1.5f * moveSpeed : moveSpeed;
@@ -533,7 +413,7 @@ void Enemy::updateEnemy(float deltaTime, Player& player, std::vector<std::unique
             setAnimationTimer(0.0f);
             setCurrentFrameIndex((getCurrentFrameIndex() + 1) % getNumFrames());
 
-            SDL_Rect& currentFrame = getCurrentFrameRef();
+            Rect& currentFrame = getCurrentFrameRef();
             currentFrame.x = getCurrentFrameIndex() * FRAME_WIDTH;
             currentFrame.y = (getDirection() + getActionOffset() * 4) * FRAME_HEIGHT;
 
@@ -545,10 +425,6 @@ void Enemy::updateEnemy(float deltaTime, Player& player, std::vector<std::unique
             }
         }
     }
-
-    if (isSpellActive()) {
-        updateSpellPosition(deltaTime, entities, game);
-    }
 }
 
 int Enemy::getActionOffset() const {
@@ -563,19 +439,19 @@ int Enemy::getActionOffset() const {
 }
 
 void Enemy::decideAction(Player& player, float distance) {
-    int randomFactor = rand() % 100;
+    int randomFactor = RandomService::stream(RANDOM_AI).nextBelow(100);
 
     if (distance > spellRange && randomFactor < 20 && spellCooldownRemaining <= 0.0f) {
         setAction(Spellcasting);
         attackCooldown = 5.0f;
-        setAttackStartTime(SDL_GetTicks());
+        setAttackStartTime(SimulationClock::getTicks());
         setAttackDelay(500);
         setDamageApplied(false);
         spellCooldownRemaining = SPELL_COOLDOWN;
     } else if (distance <= thrustRange * 1.2 && randomFactor < 60) {
         setAction(Thrusting);
         attackCooldown = 1.0f;
-        setAttackStartTime(SDL_GetTicks());
+        setAttackStartTime(SimulationClock::getTicks());
         setAttackDelay(150);
         setDamageApplied(false);
     } else {
@@ -585,8 +461,8 @@ void Enemy::decideAction(Player& player, float distance) {
     startAnimation();
 }
 
-SDL_Rect Enemy::getAttackBoundingBox() const {
-    SDL_Rect boundingBox = Entity::getAttackBoundingBox();
+Rect Enemy::getAttackBoundingBox() const {
+    Rect boundingBox = Entity::getAttackBoundingBox();
 
     if (getAction() == Thrusting) {
         int thrustRange = getThrustRange();
@@ -609,8 +485,9 @@ int Enemy::getThrustRange() const {
     return 60;
 }
 
-std::vector<std::pair<int, int>> Enemy::findPathToPlayer(Player& player, Game& game) {
-    auto& dungeonMaze = game.getDungeonMaze();
+std::vector<std::pair<int, int>> Enemy::findPathToPlayer(Player& player, SimulationContext& context) {
+    PROFILE_ZONE("Enemy::findPathToPlayer");
+    auto& dungeonMaze = context.getDungeonMaze();
     
     // Adjust enemy's starting position based on padding
     int startX = static_cast<int>((getX() + ENEMY_PADDING_X) / CELL_SIZE);
@@ -620,37 +497,5 @@ std::vector<std::pair<int, int>> Enemy::findPathToPlayer(Player& player, Game& g
     int goalX = static_cast<int>((player.getX()) / CELL_SIZE);
     int goalY = static_cast<int>((player.getY()) / CELL_SIZE);
 
-    std::vector<std::pair<int, int>> path;
-    if (startX == goalX && startY == goalY) return path;
-
-    std::priority_queue<std::tuple<int, int, int, int, std::vector<std::pair<int, int>>>> openSet;
-    std::unordered_map<int, std::unordered_map<int, int>> costSoFar;
-    openSet.emplace(0, startX, startY, 0, path);
-    costSoFar[startX][startY] = 0;
-
-    while (!openSet.empty()) {
-        auto [priority, x, y, cost, path] = openSet.top();
-        openSet.pop();
-
-        if (x == goalX && y == goalY) return path;
-
-        static const std::vector<std::pair<int, int>> directions = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
-        for (const auto& [dx, dy] : directions) {
-            int nextX = x + dx;
-            int nextY = y + dy;
-            int newCost = cost + 1;
-
-            if (nextX >= 0 && nextX < dungeonMaze[0].size() && nextY >= 0 && nextY < dungeonMaze.size() && dungeonMaze[nextY][nextX] != -1) {
-                if (!costSoFar.count(nextX) || !costSoFar[nextX].count(nextY) || newCost < costSoFar[nextX][nextY]) {
-                    costSoFar[nextX][nextY] = newCost;
-                    int priority = newCost + abs(nextX - goalX) + abs(nextY - goalY);
-                    auto newPath = path;
-                    newPath.emplace_back(nextX, nextY);
-                    openSet.emplace(priority, nextX, nextY, newCost, newPath);
-                }
-            }
-        }
-    }
-
-    return {};
+    return findPath(dungeonMaze, startX, startY, goalX, goalY);
 }
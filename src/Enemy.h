@@ -3,42 +3,46 @@
 
 #include "Entity.h"
 #include "Player.h"
-#include "Game.h"
+#include "SimulationContext.h"
 #include "PathfindingManager.h"
+#include "ProjectileSystem.h"
 #include <cstdlib>
 #include <cmath>
 #include <queue>
 #include <map>
 #include <utility>
 #include <unordered_map>
-#include <random>
+#include "Random.h"
 
 class PathfindingManager;
 
 class Enemy : public Entity {
 public:
-    Enemy(float p_x, float p_y, SDL_Texture* p_tex, int numFrames, float animationSpeed, PathfindingManager& pathfindingManager);
+    Enemy(EntityStates& states, float p_x, float p_y, SpriteSheetId p_sheet, int numFrames, float animationSpeed, PathfindingManager& pathfindingManager);
 
-    void updateBehavior(float deltaTime, Player& player, std::vector<std::unique_ptr<Entity>>& entities, Game& game);
-    void updateEnemy(float deltaTime, Player& player, std::vector<std::unique_ptr<Entity>>& entities, Game& game);
-    SDL_Rect getAttackBoundingBox() const override;
+    void updateBehavior(float deltaTime, Player& player, SimulationContext& context);
+    void updateEnemy(float deltaTime, Player& player, SimulationContext& context);
+    Rect getAttackBoundingBox() const override;
     int getThrustRange() const override;
-    void moveDirectlyToPlayer(float deltaTime, Player& player, Game& game);
+    void moveDirectlyToPlayer(float deltaTime, Player& player, SimulationContext& context);
 
     static const int INITIAL_HEALTH = 150;
     static const int THRUST_DAMAGE = 35;
     static const int SPELL_DAMAGE = 45;
     static const int SPELL_DURATION = 6000;
+    static constexpr float SPELL_SPEED = 100.0f;
     static const float SPELL_COOLDOWN;
 
-    void setSpellTarget(float targetX, float targetY) override;
-    void updateSpellPosition(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities, Game& game);
+    // The spell this enemy last cast; a new one is only cast once it is gone
+    ProjectileHandle getCastSpell() const { return castSpell; }
+    void setCastSpell(ProjectileHandle handle) { castSpell = handle; }
 
-    std::vector<std::pair<int, int>> calculateNewPath(Player& player, Game& game);
-    void followSharedPath(float deltaTime, Player& player, Game& game);
+    std::vector<std::pair<int, int>> calculateNewPath(Player& player, SimulationContext& context);
+    void followSharedPath(float deltaTime, Player& player, SimulationContext& context);
 
-    std::vector<std::pair<int, int>> pathToPlayer;
+    SharedPath pathToPlayer;
     size_t currentPathIndex;
+    void shiftPath(int dx, int dy);     // In maze cells, when the maze under the enemy moves
 
     void setMaxHealth(int health);
     int getMaxHealth() const override;
@@ -68,34 +72,22 @@ private:
     bool hasTarget;
 
     void decideAction(Player& player, float distance);
-    void randomMove(float deltaTime, Game& game);
-    void moveToNextWaypoint(float deltaTime, Player& player, Game& game);
+    void randomMove(float deltaTime, SimulationContext& context);
+    void moveToNextWaypoint(float deltaTime, Player& player, SimulationContext& context);
 
-    std::vector<std::pair<int, int>> findPathToPlayer(Player& player, Game& game);
+    std::vector<std::pair<int, int>> findPathToPlayer(Player& player, SimulationContext& context);
 
-    enum SpellState {
-        CURVED_TRAJECTORY,
-        BOUNCING
-    };
+    ProjectileHandle castSpell;
 
-    SpellState spellState;
-    Uint32 lastBounceTime;
-    float bounceDistance;
-
-    const Uint32 curveInterval = 2000;
-    const float maxBounceDistance = 500.0f;
-    int bounceCount;
-    const int maxBounces = 10;
-    float spellDirX;
-    float spellDirY;
-
-    PathfindingManager& pathfindingManager;
+    PathfindingManager* pathfindingManager;  // Pointer so enemies can be moved within the enemy pool
 
     int lastPlayerCellX;
     int lastPlayerCellY;
 
-    Uint32 lastSharedPathUpdateTime;
-    const Uint32 sharedPathUpdateInterval = 2000;
+    uint32_t lastSharedPathUpdateTime;
+    uint32_t sharedPathUpdatePhase;     // This enemy's offset into the refresh interval
+    static constexpr uint32_t sharedPathUpdateInterval = 2000;
+    void refreshSharedPath(Player& player, SimulationContext& context);
 
     int maxHealth;
     int thrustDamage;
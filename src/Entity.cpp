@@ -5,35 +5,98 @@
 const int FRAME_WIDTH = 64;
 const int FRAME_HEIGHT = 64;
 
-Entity::Entity(float p_x, float p_y, SDL_Texture* p_tex, int p_numFrames, float p_animationSpeed)
-: x(p_x), y(p_y), tex(p_tex), numFrames(p_numFrames), animationSpeed(p_animationSpeed), arrowActive(false), spellActive(false), arrowSpeed(400.0f), spellSpeed(200.0f), spellCurveFactor(0.1f), arrowMaxDistance(800.0f), arrowTravelDistance(0.0f), moving(false), running(false), direction(Down), action(Walking), health(100) {
+Entity::Entity(EntityStates& p_states, Type p_type, float p_x, float p_y, SpriteSheetId p_sheet, int p_numFrames, float p_animationSpeed)
+: damageApplied(false), attackStartTime(0), attackDelay(0), states(&p_states), stateRow(p_states.allocate(p_x, p_y, 100)), type(p_type), sheet(p_sheet), numFrames(p_numFrames), animationSpeed(p_animationSpeed), moving(false), running(false), direction(Down), action(Walking) {
     currentFrame = {0, 0, FRAME_WIDTH, FRAME_HEIGHT};
 }
 
-void Entity::updateSpellPosition(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities, Game& game) {
-    // Base class has no specific implementation.
-}
-
-bool Entity::isArrowCollidingWithWall(float arrowX, float arrowY, int cellSize, const std::vector<std::vector<int>>& dungeonMaze) {
-    int mazeX = static_cast<int>(arrowX + 32) / cellSize;
-    int mazeY = static_cast<int>(arrowY + 64) / cellSize;
-
-    if (mazeY < 0 || mazeY >= dungeonMaze.size() || mazeX < 0 || mazeX >= dungeonMaze[0].size()) {
-        return true;
-    }
-
-    return dungeonMaze[mazeY][mazeX] == -1;
-}
-
-bool Entity::isSpellCollidingWithWall(float spellX, float spellY, int cellSize, const std::vector<std::vector<int>>& dungeonMaze) {
-    int mazeX = static_cast<int>(spellX + 38) / cellSize;
-    int mazeY = static_cast<int>(spellY + 38) / cellSize;
-
-    if (mazeY < 0 || mazeY >= dungeonMaze.size() || mazeX < 0 || mazeX >= dungeonMaze[0].size()) {
-        return true;
-    }
-
-    return dungeonMaze[mazeY][mazeX] == -1;
+// Each entity owns its row: copies get a row of their own in the same
+// EntityStates, moves take the row over and leave the source without one
+Entity::Entity(const Entity& other)
+    : damageApplied(other.damageApplied), attackStartTime(other.attackStartTime), attackDelay(other.attackDelay),
+      direction(other.direction), action(other.action), states(other.states), stateRow(EntityStates::NO_ROW), moving(other.moving), running(other.running),
+      type(other.type), sheet(other.sheet), currentFrame(other.currentFrame), numFrames(other.numFrames),
+      currentFrameIndex(other.currentFrameIndex), animationSpeed(other.animationSpeed), animationTimer(other.animationTimer),
+      abilityCooldowns(other.abilityCooldowns), abilityTimers(other.abilityTimers), markedForRemoval(other.markedForRemoval) {
+    if (other.stateRow == EntityStates::NO_ROW) return;
+    stateRow = states->allocate(other.getX(), other.getY(), other.getHealth());
+    states->prevX[stateRow] = states->prevX[other.stateRow];
+    states->prevY[stateRow] = states->prevY[other.stateRow];
+}
+
+Entity::Entity(Entity&& other) noexcept
+    : damageApplied(other.damageApplied), attackStartTime(other.attackStartTime), attackDelay(other.attackDelay),
+      direction(other.direction), action(other.action), states(other.states), stateRow(other.stateRow), moving(other.moving), running(other.running),
+      type(other.type), sheet(other.sheet), currentFrame(other.currentFrame), numFrames(other.numFrames),
+      currentFrameIndex(other.currentFrameIndex), animationSpeed(other.animationSpeed), animationTimer(other.animationTimer),
+      abilityCooldowns(std::move(other.abilityCooldowns)), abilityTimers(std::move(other.abilityTimers)),
+      markedForRemoval(other.markedForRemoval) {
+    other.stateRow = EntityStates::NO_ROW;
+}
+
+Entity& Entity::operator=(const Entity& other) {
+    if (this == &other) return *this;
+
+    damageApplied = other.damageApplied;
+    attackStartTime = other.attackStartTime;
+    attackDelay = other.attackDelay;
+    direction = other.direction;
+    action = other.action;
+    moving = other.moving;
+    running = other.running;
+    type = other.type;
+    sheet = other.sheet;
+    currentFrame = other.currentFrame;
+    numFrames = other.numFrames;
+    currentFrameIndex = other.currentFrameIndex;
+    animationSpeed = other.animationSpeed;
+    animationTimer = other.animationTimer;
+    abilityCooldowns = other.abilityCooldowns;
+    abilityTimers = other.abilityTimers;
+    markedForRemoval = other.markedForRemoval;
+
+    // A moved-from source has no state to copy; neither does this afterwards
+    if (stateRow != EntityStates::NO_ROW) states->release(stateRow);
+    stateRow = EntityStates::NO_ROW;
+    states = other.states;
+    if (other.stateRow == EntityStates::NO_ROW) return *this;
+
+    stateRow = states->allocate(other.getX(), other.getY(), other.getHealth());
+    states->prevX[stateRow] = states->prevX[other.stateRow];
+    states->prevY[stateRow] = states->prevY[other.stateRow];
+    return *this;
+}
+
+Entity& Entity::operator=(Entity&& other) noexcept {
+    if (this == &other) return *this;
+    if (stateRow != EntityStates::NO_ROW) states->release(stateRow);
+
+    damageApplied = other.damageApplied;
+    attackStartTime = other.attackStartTime;
+    attackDelay = other.attackDelay;
+    direction = other.direction;
+    action = other.action;
+    states = other.states;
+    stateRow = other.stateRow;
+    moving = other.moving;
+    running = other.running;
+    type = other.type;
+    sheet = other.sheet;
+    currentFrame = other.currentFrame;
+    numFrames = other.numFrames;
+    currentFrameIndex = other.currentFrameIndex;
+    animationSpeed = other.animationSpeed;
+    animationTimer = other.animationTimer;
+    abilityCooldowns = std::move(other.abilityCooldowns);
+    abilityTimers = std::move(other.abilityTimers);
+    markedForRemoval = other.markedForRemoval;
+
+    other.stateRow = EntityStates::NO_ROW;
+    return *this;
+}
+
+Entity::~Entity() {
+    if (stateRow != EntityStates::NO_ROW) states->release(stateRow);
 }
 
 void Entity::updateCooldowns(float deltaTime) {
@@ -62,60 +125,23 @@ void Entity::setCooldown(const std::string& ability, float time) {
 }
 
 void Entity::takeDamage(int damage) {
+    int& health = stateHealth();
     health -= damage;
     if (health <= 0) {
         health = 0;
-        if (dynamic_cast<Enemy*>(this)) {
+        if (type == EnemyEntity) {
             markForRemoval();
         }
     }
 }
 
-void Entity::handleInput(const SDL_Event& event) {
-    // Base class method is empty because it's meant to be overridden by derived classes
-}
-
-void Entity::setSpellRow(int row) {
-    int spellRow = row;
-    int spellFrameIndex = (SDL_GetTicks() / 50) % 6; // Assuming 6 frames for the spell animation
-    currentFrame = {spellFrameIndex * FRAME_WIDTH, spellRow * FRAME_HEIGHT, FRAME_WIDTH, FRAME_HEIGHT};
-}
-
-SDL_Rect Entity::getSpellFrameForEnemy() const {
-    if (spellActive) {
-        int spellRow = 13; // Row for the enemy's spell animation
-        int spellFrameIndex = (SDL_GetTicks() / 50) % 6; // Assuming 6 frames for the spell animation
-        return {spellFrameIndex * FRAME_WIDTH, spellRow * FRAME_HEIGHT, FRAME_WIDTH, FRAME_HEIGHT};
-    }
-    return currentFrame;
-}
-
-void Entity::setSpellTarget(float targetX, float targetY) {
-    spellActive = true;
-    spellX = x + FRAME_WIDTH / 2;
-    spellY = y - 40;
-    spellTargetX = targetX;
-    spellTargetY = targetY;
-    spellStartTime = SDL_GetTicks();
-    spellDuration = 4000;
-}
-
-SDL_Rect Entity::getSpellFrame() const {
-    if (spellActive) {
-        int spellRow = 25;
-        int spellFrameIndex = (SDL_GetTicks() / 50) % 6; // Assuming 6 frames for the spell animation
-        return {spellFrameIndex * FRAME_WIDTH, spellRow * FRAME_HEIGHT, FRAME_WIDTH, FRAME_HEIGHT};
-    }
-    return currentFrame;
-}
-
-SDL_Rect Entity::getCollisionBoundingBox() const {
-    SDL_Rect boundingBox = { static_cast<int>(x) + 10, static_cast<int>(y) + 10, FRAME_WIDTH - 20, FRAME_HEIGHT - 20 };
+Rect Entity::getCollisionBoundingBox() const {
+    Rect boundingBox = { static_cast<int>(getX()) + 10, static_cast<int>(getY()) + 10, FRAME_WIDTH - 20, FRAME_HEIGHT - 20 };
     return boundingBox;
 }
 
-SDL_Rect Entity::getAttackBoundingBox() const {
-    SDL_Rect boundingBox = getBoundingBox();
+Rect Entity::getAttackBoundingBox() const {
+    Rect boundingBox = getBoundingBox();
     int thrustRange = getThrustRange();
 
     if (action == Slashing) {
@@ -145,8 +171,8 @@ SDL_Rect Entity::getAttackBoundingBox() const {
     return boundingBox;
 }
 
-SDL_Rect Entity::getBoundingBox() const {
-    SDL_Rect boundingBox = { static_cast<int>(x), static_cast<int>(y), FRAME_WIDTH, FRAME_HEIGHT };
+Rect Entity::getBoundingBox() const {
+    Rect boundingBox = { static_cast<int>(getX()), static_cast<int>(getY()), FRAME_WIDTH, FRAME_HEIGHT };
 
     if (action == Slashing) {
         switch (direction) {
@@ -180,25 +206,31 @@ SDL_Rect Entity::getBoundingBox() const {
 }
 
 void Entity::setX(float p_x) {
-    x = p_x;
+    stateX() = p_x;
 }
 
 void Entity::setY(float p_y) {
-    y = p_y;
+    stateY() = p_y;
 }
 
-SDL_Rect Entity::getArrowFrame() const {
-    if (arrowActive) {
-        int arrowRowOffset = 0;
-        switch (arrowDirection) {
-            case Up:    arrowRowOffset = 20; break;
-            case Down:  arrowRowOffset = 22; break;
-            case Left:  arrowRowOffset = 21; break;
-            case Right: arrowRowOffset = 23; break;
-        }
-        return {0, FRAME_HEIGHT * arrowRowOffset, FRAME_WIDTH, FRAME_HEIGHT};
-    }
-    return currentFrame;
+void Entity::savePreviousPosition() {
+    states->prevX[stateRow] = states->x[stateRow];
+    states->prevY[stateRow] = states->y[stateRow];
+}
+
+void Entity::translate(float dx, float dy) {
+    states->x[stateRow] += dx;
+    states->y[stateRow] += dy;
+    states->prevX[stateRow] += dx;
+    states->prevY[stateRow] += dy;
+}
+
+float Entity::getRenderX(float alpha) const {
+    return states->prevX[stateRow] + (states->x[stateRow] - states->prevX[stateRow]) * alpha;
+}
+
+float Entity::getRenderY(float alpha) const {
+    return states->prevY[stateRow] + (states->y[stateRow] - states->prevY[stateRow]) * alpha;
 }
 
 void Entity::setAction(Action act) {
@@ -257,25 +289,8 @@ void Entity::update(float deltaTime) {
         return;
     }
 
-    float actualSpeed = running ? 1.5f * arrowSpeed : arrowSpeed;
     float actualAnimationSpeed = running ? animationSpeed / 1.5f : animationSpeed;
 
-    if (arrowActive) {
-        float distance = arrowSpeed * deltaTime;
-        arrowTravelDistance += distance;
-
-        switch (arrowDirection) {
-            case Up:    arrowY -= distance; break;
-            case Down:  arrowY += distance; break;
-            case Left:  arrowX -= distance; break;
-            case Right: arrowX += distance; break;
-        }
-
-        if (arrowTravelDistance >= arrowMaxDistance) {
-            arrowActive = false;
-        }
-    }
-
     if (moving || action != Walking) {
         animationTimer += deltaTime;
 
@@ -316,55 +331,9 @@ int Entity::getActionOffset() const {
     return actionOffset;
 }
 
-void Entity::shootArrow(Direction dir) {
-    if (!arrowActive) {
-        arrowActive = true;
-        float xOffset = 0;
-        float yOffset = 0;
-
-        switch (dir) {
-            case Up:
-                xOffset = FRAME_WIDTH / 2;
-                yOffset = -FRAME_HEIGHT / 4;
-                break;
-            case Down:
-                xOffset = FRAME_WIDTH / 2;
-                yOffset = FRAME_HEIGHT / 2 + 25;
-                break;
-            case Left:
-                xOffset = -FRAME_WIDTH / 4;
-                yOffset = FRAME_HEIGHT / 2;
-                break;
-            case Right:
-                xOffset = FRAME_WIDTH / 2 + 30;
-                yOffset = FRAME_HEIGHT / 2;
-                break;
-        }
-
-        arrowX = x + xOffset;
-        arrowY = y + yOffset;
-        arrowDirection = dir;
-        arrowTravelDistance = 0.0f;
-    } else {
-        arrowActive = false;
-    }
-}
-
 int Entity::getThrustRange() const {
     return 30;
 }
-void Entity::deactivateSpell() {
-    spellActive = false;
-}
-bool Entity::isSpellActive() const {
-    return spellActive;
-}
-float Entity::getSpellX() const {
-    return spellX;
-}
-float Entity::getSpellY() const {
-    return spellY;
-}
 bool Entity::isMarkedForRemoval() const {
     return markedForRemoval;
 }
@@ -372,13 +341,13 @@ void Entity::markForRemoval() {
     markedForRemoval = true;
 }
 int Entity::getHealth() const {
-    return health;
+    return stateHealth();
 }
 void Entity::setHealth(int health) {
-    this->health = health;
+    stateHealth() = health;
 }
 bool Entity::isAlive() const {
-    return health > 0;
+    return stateHealth() > 0;
 }
 bool Entity::getDamageApplied() const {
     return damageApplied;
@@ -386,28 +355,19 @@ bool Entity::getDamageApplied() const {
 void Entity::setDamageApplied(bool value) {
     damageApplied = value;
 }
-Uint32 Entity::getAttackStartTime() const {
+uint32_t Entity::getAttackStartTime() const {
     return attackStartTime;
 }
-void Entity::setAttackStartTime(Uint32 time) {
+void Entity::setAttackStartTime(uint32_t time) {
     attackStartTime = time;
 }
-Uint32 Entity::getAttackDelay() const {
+uint32_t Entity::getAttackDelay() const {
     return attackDelay;
 }
-void Entity::setAttackDelay(Uint32 delay) {
+void Entity::setAttackDelay(uint32_t delay) {
     attackDelay = delay;
 }
-float Entity::getX() {
-    return x;
-}
-float Entity::getY() {
-    return y;
-}
-SDL_Texture* Entity::getTex() {
-    return tex;
-}
-SDL_Rect Entity::getCurrentFrame() {
+Rect Entity::getCurrentFrame() {
     return currentFrame;
 }
 void Entity::startAnimation() {
@@ -434,15 +394,6 @@ void Entity::setRunning(bool running) {
 bool Entity::isRunning() const {
     return running;
 }
-bool Entity::isArrowActive() const {
-    return arrowActive;
-}
-float Entity::getArrowX() const {
-    return arrowX;
-}
-float Entity::getArrowY() const {
-    return arrowY;
-}
 float Entity::getAnimationTimer() const {
     return animationTimer;
 }
@@ -455,7 +406,7 @@ int Entity::getCurrentFrameIndex() const {
 void Entity::setCurrentFrameIndex(int index) {
     currentFrameIndex = index;
 }
-SDL_Rect& Entity::getCurrentFrameRef() {
+Rect& Entity::getCurrentFrameRef() {
     return currentFrame;
 }
 bool Entity::isEntityMoving() const {
@@ -473,6 +424,6 @@ int Entity::getNumFrames() const {
 void Entity::setNumFrames(int numFrames) {
     this->numFrames = numFrames;
 }
-void Entity::setCurrentFrame(const SDL_Rect& frame) {
+void Entity::setCurrentFrame(const Rect& frame) {
     currentFrame = frame;
 }
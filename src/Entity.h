@@ -1,36 +1,55 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <limits>
 #include <map>
+#include "Geometry.h"
+#include "EntityStates.h"
 
-class Game;
 class Enemy;
 class PathfindingManager;
 
+// Which sprite sheet an entity is drawn from; the renderer maps ids to textures
+using SpriteSheetId = int;
+const SpriteSheetId NO_SPRITE_SHEET = -1;   // Headless runs draw nothing
+
 class Entity {
 public:
     enum Direction { Up, Left, Down, Right };
+    enum Type { PlayerEntity, EnemyEntity };
     enum Action { Walking, Slashing, Thrusting, Spellcasting, Shooting, ArrowFlyingUp, ArrowFlyingDown, ArrowFlyingLeft, ArrowFlyingRight, Dying };
 
-    Entity(float p_x, float p_y, SDL_Texture* p_tex, int numFrames, float animationSpeed);
+    Entity(EntityStates& p_states, Type p_type, float p_x, float p_y, SpriteSheetId p_sheet, int numFrames, float animationSpeed);
+    virtual ~Entity();
+    Entity(const Entity& other);
+    Entity(Entity&& other) noexcept;
+    Entity& operator=(const Entity& other);
+    Entity& operator=(Entity&& other) noexcept;
+
+    Type getType() const { return type; }  // Cheap alternative to dynamic_cast in per-frame loops
 
-    float getX();
-    float getY();
+    float getX() const { return stateX(); }
+    float getY() const { return stateY(); }
     void setX(float p_x);
     void setY(float p_y);
 
-    SDL_Texture* getTex();
-    SDL_Rect getCurrentFrame();
-    void setCurrentFrame(const SDL_Rect& frame);
+    // Position at the start of the current simulation step, for render interpolation
+    void savePreviousPosition();
+    float getRenderX(float alpha) const;
+    float getRenderY(float alpha) const;
+
+    // Moves the current and previous position alike, so interpolation sees no jump
+    void translate(float dx, float dy);
+
+    SpriteSheetId getSpriteSheet() const { return sheet; }
+    Rect getCurrentFrame();
+    void setCurrentFrame(const Rect& frame);
 
     virtual void update(float deltaTime);
-    virtual void handleInput(const SDL_Event& event);
     void startAnimation();
     void stopAnimation();
     void setDirection(Direction dir);
@@ -38,22 +57,16 @@ public:
     bool isMoving() const;
     Action getAction() const;
     Direction getDirection() const;
-    void shootArrow(Direction dir);
 
     void setRunning(bool running);
     bool isRunning() const;
 
-    bool isArrowActive() const;
-    float getArrowX() const;
-    float getArrowY() const;
-    SDL_Rect getArrowFrame() const;
-
-    virtual SDL_Rect getBoundingBox() const;
-    virtual SDL_Rect getAttackBoundingBox() const;
+    virtual Rect getBoundingBox() const;
+    virtual Rect getAttackBoundingBox() const;
     virtual int getThrustRange() const;
-    virtual SDL_Rect getCollisionBoundingBox() const;
+    virtual Rect getCollisionBoundingBox() const;
 
-    static bool checkCollision(const SDL_Rect& a, const SDL_Rect& b) { return SDL_HasIntersection(&a, &b); }
+    static bool checkCollision(const Rect& a, const Rect& b) { return rectsOverlap(a, b); }
     static int getFrameWidth() { return FRAME_WIDTH; }
     static int getFrameHeight() { return FRAME_HEIGHT; }
 
@@ -65,42 +78,28 @@ public:
 
     bool getDamageApplied() const;
     void setDamageApplied(bool value);
-    Uint32 getAttackStartTime() const;
-    void setAttackStartTime(Uint32 time);
-    Uint32 getAttackDelay() const;
-    void setAttackDelay(Uint32 delay);
+    uint32_t getAttackStartTime() const;
+    void setAttackStartTime(uint32_t time);
+    uint32_t getAttackDelay() const;
+    void setAttackDelay(uint32_t delay);
 
     void setNumFrames(int numFrames);
 
-    virtual void setSpellTarget(float targetX, float targetY);
-    virtual void updateSpellPosition(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities, Game& game);
-    bool isSpellActive() const;
-    SDL_Rect getSpellFrame() const;
-    float getSpellX() const;
-    float getSpellY() const;
-    void deactivateSpell();
-
     bool isMarkedForRemoval() const;
     void markForRemoval();
 
-    void setSpellRow(int row);
-    SDL_Rect getSpellFrameForEnemy() const;
-
     virtual void updateCooldowns(float deltaTime);
     bool isCooldownActive(const std::string& ability) const;
     float getCooldownRemaining(const std::string& ability) const;
     void setCooldown(const std::string& ability, float time);
 
-    bool isArrowCollidingWithWall(float arrowX, float arrowY, int cellSize, const std::vector<std::vector<int>>& dungeonMaze);
-    bool isSpellCollidingWithWall(float spellX, float spellY, int cellSize, const std::vector<std::vector<int>>& dungeonMaze); // New method for spell collision
-
 protected:
     virtual int getActionOffset() const;
     float getAnimationTimer() const;
     void setAnimationTimer(float timer);
     int getCurrentFrameIndex() const;
     void setCurrentFrameIndex(int index);
-    SDL_Rect& getCurrentFrameRef();
+    Rect& getCurrentFrameRef();
     bool isEntityMoving() const;
     bool isEntityRunning() const;
     float getAnimationSpeed() const;
@@ -110,41 +109,34 @@ protected:
     static const int FRAME_HEIGHT = 64;
 
     bool damageApplied;
-    Uint32 attackStartTime;
-    Uint32 attackDelay;
+    uint32_t attackStartTime;
+    uint32_t attackDelay;
 
     Direction direction;
     Action action;
 
-    bool spellActive;
-    float spellX, spellY;
-    float spellTargetX, spellTargetY;
-    float spellSpeed;
-    float spellCurveFactor;
-    Uint32 spellStartTime;
-    Uint32 spellDuration;
+    // Position and health live in `states` at this row
+    EntityStates* states;
+    uint32_t stateRow;
+    float& stateX() { return states->x[stateRow]; }
+    float stateX() const { return states->x[stateRow]; }
+    float& stateY() { return states->y[stateRow]; }
+    float stateY() const { return states->y[stateRow]; }
+    int& stateHealth() { return states->health[stateRow]; }
+    int stateHealth() const { return states->health[stateRow]; }
 
-    float x, y;
     bool moving;
     bool running;
 
-    SDL_Texture* tex;
-    SDL_Rect currentFrame;
+    Type type;
+    SpriteSheetId sheet;   // Shared with every entity drawn from the same sheet
+    Rect currentFrame;
 
     int numFrames;
     int currentFrameIndex;
     float animationSpeed;
     float animationTimer;
 
-    bool arrowActive;
-    float arrowX, arrowY;
-    float arrowSpeed;
-    float arrowMaxDistance;
-    float arrowTravelDistance;
-    Direction arrowDirection;
-
-    int health;
-
     std::map<std::string, float> abilityCooldowns;
     std::map<std::string, float> abilityTimers;
 
@@ -0,0 +1,63 @@
+#ifndef ENTITYSTATES_H
+#define ENTITYSTATES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Position and health of every entity, stored as a structure of arrays: one
+// array per field, indexed by a row each entity holds for its lifetime. Rows
+// are handed out like slot map slots (freed rows are reused), so they stay
+// put while entity objects are moved around their containers. Passes that
+// only need positions or health stream through these arrays instead of
+// striding over whole entity objects.
+// The simulation owns one of these and hands it to every entity it creates;
+// it must outlive them, and like the entities it is only touched by the
+// thread that steps the simulation.
+class EntityStates {
+public:
+    static const uint32_t NO_ROW = UINT32_MAX;
+
+    uint32_t allocate(float px, float py, int hp) {
+        uint32_t row;
+        if (!freeRows.empty()) {
+            row = freeRows.back();
+            freeRows.pop_back();
+            x[row] = px;
+            y[row] = py;
+            prevX[row] = px;
+            prevY[row] = py;
+            health[row] = hp;
+        } else {
+            row = static_cast<uint32_t>(x.size());
+            x.push_back(px);
+            y.push_back(py);
+            prevX.push_back(px);
+            prevY.push_back(py);
+            health.push_back(hp);
+        }
+        return row;
+    }
+
+    void release(uint32_t row) {
+        health[row] = 0;
+        freeRows.push_back(row);
+    }
+
+    // Start-of-step snapshot for render interpolation, for every entity at once
+    void savePreviousPositions() {
+        prevX = x;
+        prevY = y;
+    }
+
+    size_t rowCount() const { return x.size(); }
+
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;
+    std::vector<int> health;
+
+private:
+    std::vector<uint32_t> freeRows;
+};
+
+#endif // ENTITYSTATES_H
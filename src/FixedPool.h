@@ -0,0 +1,93 @@
+#ifndef FIXEDPOOL_H
+#define FIXEDPOOL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity object pool with generational handles.
+// Storage is allocated once, up front: spawning and despawning only move
+// indices between a free list and a dense list of live slots, so neither
+// allocates. Objects never move, and a handle to a despawned object stops
+// resolving even after its slot is reused.
+template <typename T, size_t Capacity>
+class FixedPool {
+    static_assert(Capacity < UINT16_MAX, "FixedPool indices are 16-bit");
+
+public:
+    struct Handle {
+        uint16_t index = UINT16_MAX;
+        uint16_t generation = 0;
+
+        bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    FixedPool() { clear(); }
+
+    // Returns an invalid handle when the pool is full
+    Handle spawn(const T& value) {
+        if (freeCount == 0) return Handle();
+
+        uint16_t index = freeList[--freeCount];
+        items[index] = value;
+        livePosition[index] = static_cast<uint16_t>(liveCount);
+        liveList[liveCount++] = index;
+        return {index, generations[index]};
+    }
+
+    bool alive(Handle handle) const {
+        return handle.index < Capacity && generations[handle.index] == handle.generation && livePosition[handle.index] != DEAD;
+    }
+
+    T* get(Handle handle) { return alive(handle) ? &items[handle.index] : nullptr; }
+    const T* get(Handle handle) const { return alive(handle) ? &items[handle.index] : nullptr; }
+
+    void despawn(Handle handle) {
+        if (alive(handle)) despawnIndex(handle.index);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            generations[i]++;
+            livePosition[i] = DEAD;
+            freeList[i] = static_cast<uint16_t>(Capacity - 1 - i);
+        }
+        freeCount = Capacity;
+        liveCount = 0;
+    }
+
+    // Live objects in a dense range: live(0) .. live(size() - 1).
+    // Despawning the object at position i moves the last live one into i.
+    size_t size() const { return liveCount; }
+    T& live(size_t position) { return items[liveList[position]]; }
+    const T& live(size_t position) const { return items[liveList[position]]; }
+    Handle liveHandle(size_t position) const { return {liveList[position], generations[liveList[position]]}; }
+    void despawnLive(size_t position) { despawnIndex(liveList[position]); }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static const uint16_t DEAD = UINT16_MAX;
+
+    void despawnIndex(uint16_t index) {
+        uint16_t position = livePosition[index];
+        uint16_t last = liveList[--liveCount];
+        liveList[position] = last;
+        livePosition[last] = position;
+
+        livePosition[index] = DEAD;
+        generations[index]++;
+        freeList[freeCount++] = index;
+    }
+
+    std::array<T, Capacity> items;
+    std::array<uint16_t, Capacity> generations{};
+    std::array<uint16_t, Capacity> livePosition;
+    std::array<uint16_t, Capacity> liveList;
+    std::array<uint16_t, Capacity> freeList;
+    size_t liveCount;
+    size_t freeCount;
+};
+
+#endif // FIXEDPOOL_H
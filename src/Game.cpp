@@ -1,8 +1,9 @@
 #include "Game.h"
 #include <iostream>
+#include <fstream>
 
 /* Constructor and Destructor */
-Game::Game() : window(nullptr), renderer(nullptr), isRunning(false), player(nullptr), world(nullptr), mazeGenerator(nullptr), difficulty(0), pathfindingManager() {}
+Game::Game() : lightingManager(nullptr), window(nullptr), renderer(nullptr), headless(false), isRunning(false), player(nullptr), menu(nullptr), world(nullptr), font(nullptr), smallFont(nullptr), atlas(nullptr), spriteBatch(nullptr), textureCache(nullptr), textRenderer(nullptr), smallTextRenderer(nullptr), levelSerial(0), endlessMode(false), endlessMaze(nullptr), enemySheet(NO_SPRITE_SHEET), difficulty(0), pathfindingManager(), accumulator(0.0f), renderAlpha(1.0f), interpolateRendering(true), simulationStats(), keyState(), recording(false), terminateThreads(false) {}
 
 Game::~Game() {
     // Set terminate flag for all threads
@@ -60,6 +61,19 @@ std::string getAssetPath(const std::string& subDir = "") {
     }
 }
 
+// Helper function to get the per-user directory where world data is saved
+std::string getSavePath(const std::string& subDir = "") {
+    char* prefPath = SDL_GetPrefPath("ShadowMaze", "Game2D");
+    if (prefPath) {
+        std::string savePath = std::string(prefPath) + subDir;
+        SDL_free(prefPath);
+        return savePath;
+    } else {
+        std::cerr << "Error getting save path: " << SDL_GetError() << std::endl;
+        return "";
+    }
+}
+
 void Game::init(const char* title, int width, int height, bool fullscreen) {
     int flags = fullscreen ? SDL_WINDOW_FULLSCREEN : 0;
     if (SDL_Init(SDL_INIT_EVERYTHING) == 0) {
@@ -93,19 +107,24 @@ void Game::init(const char* title, int width, int height, bool fullscreen) {
             printf("Failed to load small font! SDL_ttf Error: %s\n", TTF_GetError());
             isRunning = false;
         }
+
+        /* Glyph atlases, rasterized once instead of on every text draw */
+        if (font) textRenderer = new TextRenderer(renderer, font);
+        if (smallFont) smallTextRenderer = new TextRenderer(renderer, smallFont, 1);
     }
 
+    textureCache = new TextureCache(renderer);
+
     /* Loading the main character and adding it to the vector */
-    SDL_Texture* tex = loadTexture(getAssetPath("sprite_good_arrow3.png").c_str());
-    player = new Player(670, 2850, tex, 4, 0.1f);
-    entities.push_back(std::unique_ptr<Entity>(player));
+    player = new Player(entityStates, 670, 2850, loadSpriteSheet("sprite_good_arrow3.png"), 4, 0.1f);
     player->setHealth(Player::INITIAL_HEALTH);                                                 /* Set the health of the player */
+    enemySheet = loadSpriteSheet("enemy4.png");
 
     lastTime = SDL_GetTicks();
     deltaTime = 0.0f;                                                       /* Getting the in-game time for the movement */
 
     menu = new Menu(this);                                                  /* Allocating memory for the menu */
-    world = new World(renderer);                                            /* Initialize the world with a seed for procedural generation */
+    world = new World(renderer, getSavePath("regions"));                    /* Initialize the world, paging visited chunks from disk */
 
     isPlayerInDungeon = false;
 
@@ -120,9 +139,6 @@ void Game::init(const char* title, int width, int height, bool fullscreen) {
             tileSize,
             tileSize
         };
-
-        // Set dungeonExit to the same coordinates
-        dungeonExit = dungeonEntrance;
     }
 
     lightingManager = new LightingManager(renderer, 1920, 1080);
@@ -131,16 +147,15 @@ void Game::init(const char* title, int width, int height, bool fullscreen) {
     // Center the camera on the player initially
     camera.x = player->getX() - camera.w / 2;
     camera.y = player->getY() - camera.h / 2;
+    previousCamera = camera;
 
     world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
 
-    tilesetTexture = loadTexture(getAssetPath("tileset.png").c_str());
-    dungeonEntranceTexture = loadTexture(getAssetPath("dungeon_entrance.png").c_str());
-    pathTileTexture = loadTexture(getAssetPath("cobblestone_2.png").c_str());
-    wallTileTexture = loadTexture(getAssetPath("Brickwall_Texture.png").c_str());
-    loadHUDTexture();                                                        /* Load the textures */
+    loadAtlas();                                                             /* Load the textures */
+    spriteBatch = new SpriteBatch(renderer);
 
     terminateThreads = false;
+    levelBuilder.prefetch(0, getLevelSeed());                                /* The dungeon is entered at difficulty 0 */
 
     dungeonThreadHandle = std::thread(&Game::dungeonGenerationThread, this);
     lightingThreadHandle = std::thread(&Game::lightingThread, this);
@@ -148,6 +163,145 @@ void Game::init(const char* title, int width, int height, bool fullscreen) {
     playerEnemyActionThreadHandle = std::thread(&Game::playerEnemyActionThread, this);
 }
 
+void Game::initHeadless() {
+    headless = true;
+    window = nullptr;
+    renderer = nullptr;
+    font = nullptr;
+    smallFont = nullptr;
+    menu = nullptr;
+    world = nullptr;
+    lightingManager = nullptr;
+    menu = new Menu(this);  // Only reacts to replayed input; never drawn
+
+    // Timer only: no window, renderer, images, fonts or overworld streaming
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+        isRunning = false;
+        return;
+    }
+
+    player = new Player(entityStates, 670, 2850, NO_SPRITE_SHEET, 4, 0.1f);
+    player->setHealth(Player::INITIAL_HEALTH);
+
+    lastTime = SDL_GetTicks();
+    deltaTime = 0.0f;
+    isMenuOpen = false;
+    isPlayerInDungeon = false;
+    terminateThreads = false;
+
+    camera = {0, 0, 1680, 900};
+    camera.x = player->getX() - camera.w / 2;
+    camera.y = player->getY() - camera.h / 2;
+    previousCamera = camera;
+
+    headlessStats = HeadlessStats();
+    levelBuilder.prefetch(0, getLevelSeed());
+    isRunning = true;
+}
+
+SpriteSheetId Game::loadSpriteSheet(const std::string& file) {
+    if (headless) return NO_SPRITE_SHEET;  // Nothing is drawn, so sprite sheets are never loaded
+
+    std::shared_ptr<SDL_Texture> texture = textureCache->load(getAssetPath(file));
+    for (size_t i = 0; i < spriteSheets.size(); ++i) {
+        if (spriteSheets[i] == texture) return static_cast<SpriteSheetId>(i);
+    }
+    spriteSheets.push_back(std::move(texture));
+    return static_cast<SpriteSheetId>(spriteSheets.size() - 1);
+}
+
+SDL_Texture* Game::getSpriteSheetTexture(SpriteSheetId sheet) const {
+    if (sheet < 0 || sheet >= static_cast<int>(spriteSheets.size())) return nullptr;
+    return spriteSheets[sheet].get();
+}
+
+void Game::runHeadless(int levels) {
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    while (isRunning && headlessStats.levelsCompleted < levels) {
+        Profiler::beginFrame();
+        update();
+        Profiler::endFrame();
+    }
+
+    double seconds = (SDL_GetPerformanceCounter() - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    printf("Headless run (seed %llu): %d levels (%d cleared, %d timed out), %d deaths, %llu steps in %.2fs\n",
+           static_cast<unsigned long long>(RandomService::getSeed()), headlessStats.levelsCompleted, headlessStats.levelsCleared, headlessStats.levelsCompleted - headlessStats.levelsCleared,
+           headlessStats.deaths, static_cast<unsigned long long>(simulationStats.totalSteps), seconds);
+    if (seconds > 0.0) {
+        printf("  %.0f levels/min, %.0f steps/s\n", headlessStats.levelsCompleted * 60.0 / seconds, simulationStats.totalSteps / seconds);
+    }
+}
+
+void Game::updateHeadless() {
+    // Runs one simulation step per call, as fast as the caller loops
+    if (!isPlayerInDungeon) {
+        enterDungeon();
+        headlessLevelStart = SimulationClock::getTicks();
+    }
+
+    driveHeadlessPlayer();
+    step(FIXED_TIMESTEP);
+
+    if (player->getIsDead()) {
+        // Respawn straight back into a fresh dungeon instead of the respawn menu
+        headlessStats.deaths++;
+        resetGame();
+        return;
+    }
+
+    bool cleared = areAllEnemiesCleared();
+    bool timedOut = SimulationClock::getTicks() - headlessLevelStart >= HEADLESS_LEVEL_TIME;
+    if (cleared || timedOut) {
+        headlessStats.levelsCompleted++;
+        if (cleared) headlessStats.levelsCleared++;
+
+        // Cycle through a bounded range of difficulties so mazes don't grow without limit
+        if (endlessMaze) {
+            startEndless();
+        } else if (difficulty < HEADLESS_MAX_DIFFICULTY) {
+            transitionToNextLevel();
+        } else {
+            difficulty = 0;
+            startLevel(difficulty);
+        }
+        headlessLevelStart = SimulationClock::getTicks();
+    }
+}
+
+void Game::driveHeadlessPlayer() {
+    // Stand-in for a human: face the closest enemy and attack it through the
+    // same input handling the keyboard and mouse use
+    Enemy* closestEnemy = nullptr;
+    float minDistance = std::numeric_limits<float>::max();
+    for (auto& enemy : enemies) {
+        float distance = std::hypot(player->getX() - enemy.getX(), player->getY() - enemy.getY());
+        if (distance < minDistance) {
+            minDistance = distance;
+            closestEnemy = &enemy;
+        }
+    }
+    if (!closestEnemy || player->getAction() != Entity::Walking) return;
+
+    float dx = closestEnemy->getX() - player->getX();
+    float dy = closestEnemy->getY() - player->getY();
+    if (std::fabs(dx) > std::fabs(dy)) {
+        player->setDirection(dx > 0 ? Entity::Right : Entity::Left);
+    } else {
+        player->setDirection(dy > 0 ? Entity::Down : Entity::Up);
+    }
+
+    if (minDistance < 150.0f) {
+        player->handleInput(PlayerInput::StartThrust);
+    } else if (!player->isCooldownActive("Spellcasting")) {
+        player->handleInput(PlayerInput::CastSpell);
+    } else if (!player->isCooldownActive("Shooting")) {
+        player->handleInput(PlayerInput::DrawBow);
+        player->handleInput(PlayerInput::ReleaseBow);
+    }
+}
+
 void Game::dungeonGenerationThread() {
     while (true) {
         std::unique_lock<std::mutex> lock(dungeonMutex);
@@ -174,25 +328,19 @@ void Game::lightingThread() {
             // Ensure thread-safe access to entities when calculating positions
             std::lock_guard<std::mutex> entityLock(entityMutex);
 
-            for (const auto& entity : entities) {
-                if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                    SDL_Rect enemyRect = {
-                        static_cast<int>(enemy->getX()) - camera.x,
-                        static_cast<int>(enemy->getY()) - camera.y,
-                        static_cast<int>(enemy->getCurrentFrame().w * 2),
-                        static_cast<int>(enemy->getCurrentFrame().h * 2)
-                    };
-                    enemyPositions.push_back(enemyRect);
-                }
+            for (auto& enemy : enemies) {
+                SDL_Rect enemyRect = {
+                    static_cast<int>(enemy.getX()) - camera.x,
+                    static_cast<int>(enemy.getY()) - camera.y,
+                    static_cast<int>(enemy.getCurrentFrame().w * 2),
+                    static_cast<int>(enemy.getCurrentFrame().h * 2)
+                };
+                enemyPositions.push_back(enemyRect);
+            }
 
-                if (entity->isSpellActive()) {
-                    SDL_Rect spellRect = {
-                        static_cast<int>(entity->getSpellX()) - camera.x,
-                        static_cast<int>(entity->getSpellY()) - camera.y,
-                        64, // Width of the spell texture
-                        64  // Height of the spell texture
-                    };
-                    spellPositions.push_back(spellRect);
+            for (size_t i = 0; i < projectiles.size(); ++i) {
+                if (projectiles.get(i).kind == Projectile::Spell) {
+                    spellPositions.push_back(getProjectileRect(projectiles.get(i)));
                 }
             }
         }
@@ -202,7 +350,7 @@ void Game::lightingThread() {
             {static_cast<int>(player->getX()), static_cast<int>(player->getY()), player->getCurrentFrame().w * 2, player->getCurrentFrame().h * 2},
             enemyPositions,
             spellPositions,
-            dungeonMaze,
+            dungeonOccluders,
             camera
         );
     }
@@ -217,18 +365,16 @@ void Game::pathfindingThread() {
         if (terminateThreads) break;
 
         // Handle pathfinding requests asynchronously
-        for (auto& entity : entities) {
-            if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                // Get path to player
-                auto path = pathfindingManager.getSharedPathToPlayer(*player, *this, *enemy);
-                
-                // Update the enemy's path directly
-                enemy->pathToPlayer = path;
-                enemy->currentPathIndex = 0;  // Reset path index to start at the beginning
-
-                // Follow the path
-                enemy->followSharedPath(deltaTime, *player, *this);
-            }
+        for (auto& enemy : enemies) {
+            // Get path to player
+            SharedPath path = pathfindingManager.getSharedPathToPlayer(*player, *this, enemy);
+            
+            // Update the enemy's path directly
+            enemy.pathToPlayer = path;
+            enemy.currentPathIndex = 0;  // Reset path index to start at the beginning
+
+            // Follow the path
+            enemy.followSharedPath(deltaTime, *player, *this);
         }
     }
 }
@@ -242,14 +388,12 @@ void Game::playerEnemyActionThread() {
 
         // Process player actions
         if (!isMenuOpen && !player->getIsDead()) {
-            player->update(deltaTime, entities, *this);
+            player->update(deltaTime, enemies, *this);
         }
 
         // Process enemy actions
-        for (auto& entity : entities) {
-            if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                enemy->updateBehavior(deltaTime, *player, entities, *this);
-            }
+        for (auto& enemy : enemies) {
+            enemy.updateBehavior(deltaTime, *player, *this);
         }
     }
 }
@@ -265,45 +409,38 @@ std::pair<int, int> Game::findDungeonEntrancePosition() {
     return {-1, -1};  // Return an invalid position if no dungeon entrance is found
 }
 
-SDL_Texture* Game::loadTexture(const char* fileName) {                      /* Method for loading the texture for the main character */
-    SDL_Surface* tempSurface = IMG_Load(fileName);
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, tempSurface);
-    SDL_FreeSurface(tempSurface);
-    return tex;
-}
-
 void Game::spawnEnemy() {
-    SDL_Texture* enemyTex = loadTexture(getAssetPath("enemy4.png").c_str());
     float x = 540;
     float y = 100;
     
     // Remove or adapt the PathfindingManager reference as needed.
-    auto enemy = std::make_unique<Enemy>(x, y, enemyTex, 8, 0.1f, pathfindingManager);
+    Enemy* enemy = enemies.get(enemies.emplace(entityStates, x, y, enemySheet, 8, 0.1f, pathfindingManager));
     enemy->setHealth(Enemy::INITIAL_HEALTH);
-    entities.push_back(std::move(enemy));
 }
 
 void Game::resetGame(bool resetDungeon) {
     // Clear all entities, including enemies
-    for (auto& entity : entities) {
-        entity.reset();
-    }
-    entities.clear();
+    enemies.clear();
+    projectiles.clear();
+    delete player;
 
     // Reinitialize the player
-    player = new Player(670, 2850, loadTexture(getAssetPath("sprite_good_arrow3.png").c_str()), 4, 0.1f);
+    player = new Player(entityStates, 670, 2850, loadSpriteSheet("sprite_good_arrow3.png"), 4, 0.1f);
     player->setHealth(Player::INITIAL_HEALTH);
-    entities.push_back(std::unique_ptr<Entity>(player));
 
-    // Reset the world
-    world = new World(renderer);
+    // Reset the world; headless runs never leave the dungeon and don't stream it
+    delete world;
+    world = headless ? nullptr : new World(renderer, getSavePath("regions"));
 
     // Reset the camera position
     camera = {0, 0, 1680, 900};
     camera.x = player->getX() - camera.w / 2;
     camera.y = player->getY() - camera.h / 2;
+    snapInterpolation();
 
-    world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
+    if (world) {
+        world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
+    }
 
     isMenuOpen = false;
     isRunning = true;
@@ -312,10 +449,9 @@ void Game::resetGame(bool resetDungeon) {
         // Reset dungeon state
         isPlayerInDungeon = false;
         difficulty = 0;
-        if (mazeGenerator) {
-            delete mazeGenerator;
-            mazeGenerator = nullptr;
-        }
+        stopEndless();
+        pathfindingManager.clear();
+        levelBuilder.prefetch(0, getLevelSeed());
 
         int tileSize = 96;
         
@@ -335,46 +471,252 @@ void Game::resetGame(bool resetDungeon) {
 /* Handling the events of the game such as the opening of the menu, if the game is running or not
    and some more are coming  */
 void Game::handleEvents() {
+    PROFILE_ZONE("Game::handleEvents");
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) {
-            isRunning = false;
-        } else if (isMenuOpen) {
-            menu->handleInput(event);
-        } else {
-            // Process game-specific inputs first
-            switch (event.type) {
-                case SDL_KEYDOWN:
-                    if (event.key.keysym.sym == SDLK_ESCAPE) {
-                        if (isMenuOpen) {
-                            menu->setState(Menu::NONE);
-                            isMenuOpen = false;
-                        } else {
-                            menu->setState(Menu::MAIN_MENU);
-                            isMenuOpen = true;
-                        }
+        if (recording && InputLog::isRecordable(event)) {
+            inputLog.record(static_cast<uint32_t>(simulationStats.totalSteps), event);
+        }
+        handleEvent(event);
+    }
+}
+
+void Game::handleEvent(const SDL_Event& event) {
+    if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
+        keyState[event.key.keysym.scancode] = event.type == SDL_KEYDOWN;
+    }
+
+    if (event.type == SDL_QUIT) {
+        isRunning = false;
+    } else if (isMenuOpen) {
+        SDL_Event menuEvent = event;
+        menu->handleInput(menuEvent);
+    } else {
+        // Process game-specific inputs first
+        switch (event.type) {
+            case SDL_KEYDOWN:
+                if (event.key.keysym.sym == SDLK_F3) {
+                    if (!event.key.repeat) perfOverlay.toggle();
+                } else if (event.key.keysym.sym == SDLK_ESCAPE) {
+                    if (isMenuOpen) {
+                        menu->setState(Menu::NONE);
+                        isMenuOpen = false;
                     } else {
-                        player->handleInput(event);  // Pass other key events to player
+                        menu->setState(Menu::MAIN_MENU);
+                        isMenuOpen = true;
                     }
-                    break;
-                case SDL_KEYUP:
-                    player->handleInput(event);  // Handle key release events
-                    break;
-                case SDL_MOUSEBUTTONDOWN:
-                case SDL_MOUSEBUTTONUP:
-                    player->handleInput(event);  // Pass mouse events to player
-                    break;
-                default:
-                    break;
+                } else if (event.key.keysym.sym == SDLK_e) {
+                    player->handleInput(PlayerInput::Slash);
+                } else if (event.key.keysym.sym == SDLK_q) {
+                    player->handleInput(PlayerInput::CastSpell);
+                } else if (event.key.keysym.sym == SDLK_LSHIFT || event.key.keysym.sym == SDLK_RSHIFT) {
+                    player->handleInput(PlayerInput::StartRunning);
+                }
+                break;
+            case SDL_KEYUP:
+                if (event.key.keysym.sym == SDLK_LSHIFT || event.key.keysym.sym == SDLK_RSHIFT) {
+                    player->handleInput(PlayerInput::StopRunning);
+                }
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+                if (event.button.button == SDL_BUTTON_LEFT) {
+                    player->handleInput(PlayerInput::DrawBow);
+                } else if (event.button.button == SDL_BUTTON_RIGHT) {
+                    player->handleInput(PlayerInput::StartThrust);
+                }
+                break;
+            case SDL_MOUSEBUTTONUP:
+                if (event.button.button == SDL_BUTTON_LEFT) {
+                    player->handleInput(PlayerInput::ReleaseBow);
+                } else if (event.button.button == SDL_BUTTON_RIGHT) {
+                    player->handleInput(PlayerInput::EndThrust);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void Game::startRecording(const std::string& path) {
+    inputLog.clear();
+    inputLog.setSeed(RandomService::getSeed());
+    recordingPath = path;
+    recording = true;
+}
+
+void Game::stopRecording() {
+    if (!recording) return;
+
+    recording = false;
+    inputLog.setEndTick(static_cast<uint32_t>(simulationStats.totalSteps));
+    if (inputLog.save(recordingPath)) {
+        printf("Recorded %zu input events over %u steps to %s\n", inputLog.size(), inputLog.getEndTick(), recordingPath.c_str());
+    }
+}
+
+void Game::runReplay(const InputLog& log, const std::string& timingPath) {
+    std::ofstream timing;
+    if (!timingPath.empty()) {
+        timing.open(timingPath, std::ios::trunc);
+        if (timing) {
+            timing << "frame,tick,simulation_ms,render_ms\n";
+        } else {
+            std::cerr << "Failed to open frame timing file " << timingPath << std::endl;
+        }
+    }
+
+    double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    double totalSimulationMs = 0.0;
+    double totalRenderMs = 0.0;
+    size_t next = 0;
+    Uint32 frame = 0;
+
+    // One step per frame, with each recorded event handled right before the step it preceded live
+    while (isRunning && simulationStats.totalSteps < log.getEndTick()) {
+        if (!headless) {
+            SDL_Event event;
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_QUIT) isRunning = false;  // Live input is otherwise ignored
             }
         }
+
+        Profiler::beginFrame();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        while (next < log.size() && log[next].tick <= simulationStats.totalSteps) {
+            handleEvent(InputLog::toEvent(log[next++]));
+        }
+        if (!isRunning) break;
+
+        if (isMenuOpen) {
+            // Live, no steps run while the menu is open, so the events that close it share this tick
+            std::cerr << "Replay diverged: menu still open at step " << simulationStats.totalSteps << std::endl;
+            break;
+        }
+
+        step(FIXED_TIMESTEP);
+        Uint64 simulationEnd = SDL_GetPerformanceCounter();
+        if (!headless) {
+            renderAlpha = 1.0f;
+            render();
+        }
+        Uint64 frameEnd = SDL_GetPerformanceCounter();
+        Profiler::endFrame();
+
+        double simulationMs = (simulationEnd - frameStart) * 1000.0 / frequency;
+        double renderMs = (frameEnd - simulationEnd) * 1000.0 / frequency;
+        totalSimulationMs += simulationMs;
+        totalRenderMs += renderMs;
+        if (timing) {
+            timing << frame << ',' << simulationStats.totalSteps << ',' << simulationMs << ',' << renderMs << '\n';
+        }
+        frame++;
+    }
+
+    if (frame > 0) {
+        printf("Replay (seed %llu): %u frames, %.3f ms simulation, %.3f ms render per frame\n",
+               static_cast<unsigned long long>(log.getSeed()), frame, totalSimulationMs / frame, totalRenderMs / frame);
     }
 }
 
+bool Game::runScenario(const std::string& name, int frames, ScenarioResult& result) {
+    bool outdoorWalk = name == "outdoor-walk";
+    bool spellSwarm = name == "spell-swarm";
+    bool endlessDescent = name == "endless-descent";
+    int dungeonDifficulty = -1;
+    if (name == "dungeon-0") dungeonDifficulty = 0;
+    else if (name == "dungeon-10") dungeonDifficulty = 10;
+    else if (name == "dungeon-50") dungeonDifficulty = 50;
+    else if (spellSwarm) dungeonDifficulty = 10;
+
+    if (!outdoorWalk && !endlessDescent && dungeonDifficulty < 0) {
+        std::cerr << "Unknown scenario " << name << std::endl;
+        return false;
+    }
+
+    // Same content whatever ran before: fresh state, reseeded streams, and a
+    // world without region files so every chunk is generated the same way
+    RandomService::seed(RandomService::getSeed());
+    levelSerial = 0;
+    resetGame(true);
+    delete world;
+    world = new World(renderer);
+    world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
+    world->waitForRequestedChunks();  // Otherwise short runs can finish before the first chunk streams in
+
+    if (dungeonDifficulty >= 0) {
+        lastPlayerX = player->getX();
+        lastPlayerY = player->getY();
+        isPlayerInDungeon = true;
+        difficulty = dungeonDifficulty;
+        startLevel(difficulty);
+        if (spellSwarm) {
+            enemies.clear();
+            spawnEnemiesInDungeon(200);
+        }
+    } else if (endlessDescent) {
+        lastPlayerX = player->getX();
+        lastPlayerY = player->getY();
+        isPlayerInDungeon = true;
+        startEndless();
+    }
+
+    double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    std::vector<double> updateMs;
+    std::vector<double> renderMs;
+    updateMs.reserve(frames);
+    renderMs.reserve(frames);
+
+    // One step and one render per frame, timed separately
+    for (int frame = 0; frame < SCENARIO_WARMUP_FRAMES + frames && isRunning; ++frame) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) isRunning = false;  // Live input is otherwise ignored
+        }
+
+        Profiler::beginFrame();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        if (outdoorWalk) {
+            // Wraps at the map's east edge so the camera keeps crossing chunks that have tiles
+            float mapPixels = static_cast<float>(mapMatrix[0].size() * LevelBuilder::TILE_SIZE);
+            player->setX(std::fmod(player->getX() + SCENARIO_WALK_SPEED * FIXED_TIMESTEP, mapPixels));
+        } else if (endlessDescent) {
+            player->setHealth(Player::INITIAL_HEALTH);
+            player->setY(player->getY() + SCENARIO_WALK_SPEED * FIXED_TIMESTEP);     // Through the walls, like outdoor-walk
+        } else {
+            player->setHealth(Player::INITIAL_HEALTH);  // Kept alive so every frame measures the same fight
+            if (!spellSwarm) driveHeadlessPlayer();
+        }
+
+        step(FIXED_TIMESTEP);
+        if (outdoorWalk) {
+            camera.x = static_cast<int>(player->getX()) - camera.w / 2;
+            camera.y = static_cast<int>(player->getY()) - camera.h / 2;
+            world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
+        }
+        Uint64 simulationEnd = SDL_GetPerformanceCounter();
+
+        renderAlpha = 1.0f;
+        render();
+        Uint64 frameEnd = SDL_GetPerformanceCounter();
+        Profiler::endFrame();
+
+        if (frame >= SCENARIO_WARMUP_FRAMES) {
+            updateMs.push_back((simulationEnd - frameStart) * 1000.0 / frequency);
+            renderMs.push_back((frameEnd - simulationEnd) * 1000.0 / frequency);
+        }
+    }
+
+    result = summarizeScenario(name, std::move(updateMs), std::move(renderMs));
+    printf("Scenario %s: %d frames, update p95 %.3f ms p99 %.3f ms, render p95 %.3f ms p99 %.3f ms\n",
+           name.c_str(), result.frames, result.updateP95Ms, result.updateP99Ms, result.renderP95Ms, result.renderP99Ms);
+    return true;
+}
+
 void Game::processInput() {
     if (isMenuOpen) return;
 
-    const Uint8* state = SDL_GetKeyboardState(NULL);
+    const Uint8* state = keyState;
     bool moved = false;
 
     float speed = player->isRunning() ? 200.0f : 100.0f;
@@ -404,7 +746,7 @@ void Game::processInput() {
 
     if (moved) {
         // Wall collision handling for both inside and outside the dungeon
-        SDL_Rect playerRect = player->getBoundingBox();
+        Rect playerRect = player->getBoundingBox();
         float playerLeft = newX;
         float playerRight = newX + playerRect.w - 8;
         float playerTop = newY + 16;
@@ -464,47 +806,28 @@ void Game::processInput() {
     }
 }
 
-void Game::updateEnemySpellAnimation(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities) {
-    for (const auto& entity : entities) {
-        if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-            if (enemy->getAction() == Entity::Spellcasting && !enemy->isSpellActive()) {
-                enemy->setSpellTarget(player->getX(), player->getY());
-            }
-            enemy->updateSpellPosition(deltaTime, entities, *this);
-
-            // Ensure the enemy's texture is restored after spellcasting
-            if (enemy->getAction() == Entity::Spellcasting && !enemy->isSpellActive()) {
-                enemy->setAction(Entity::Walking); // Set back to walking after spellcasting
-            }
-        }
-    }
-}
-
 bool Game::checkDungeonEntrance() {
     SDL_Rect playerRect = {static_cast<int>(player->getX()), static_cast<int>(player->getY()), 64, 64};
     return SDL_HasIntersection(&playerRect, &dungeonEntrance);
 }
 
 void Game::startLevel(int difficulty) {
-    if (mazeGenerator) {
-        delete mazeGenerator;
-    }
-
-    int mazeWidth = 21 + difficulty;
-    int mazeHeight = 21 + difficulty;
-
-    mazeGenerator = new MazeGenerator(mazeWidth, mazeHeight);
-    dungeonMaze = mazeGenerator->generateMaze();
-
-    // Set specific positions for the dungeon entrance (top-left) and exit (outer world position)
-    int entranceX = 1; // Top-left corner of the dungeon
-    int entranceY = 1;
-    int exitX = mazeWidth - 2; // Bottom-right corner of the dungeon
-    int exitY = mazeHeight - 2;
-
-    // Mark the entrance and exit in the dungeon matrix
-    dungeonMaze[entranceY][entranceX] = 2; // 2 represents entrance
-    dungeonMaze[exitY][exitX] = 3;         // 3 represents exit for next level
+    PROFILE_ZONE("Game::startLevel");
+    stopEndless();
+
+    // Usually prefetched while the previous level was played, so this is a swap
+    LevelPlan level = levelBuilder.take(difficulty, getLevelSeed());
+    levelSerial++;
+    dungeonMaze = std::move(level.maze);
+    dungeonOccluders = std::move(level.occluders);
+    spawnCells = std::move(level.spawnCells);
+    levelMetadata = std::move(level.metadata);
+    pathfindingManager.clear();     // Paths through the previous maze
+
+    int mazeWidth = dungeonMaze.getWidth();
+    int mazeHeight = dungeonMaze.getHeight();
+    int entranceX = level.entranceX;
+    int entranceY = level.entranceY;
 
     int cellSize = 96;
 
@@ -522,58 +845,127 @@ void Game::startLevel(int difficulty) {
     camera.x = std::max(0, std::min(camera.x, mazePixelWidth - camera.w));
     camera.y = std::max(0, std::min(camera.y, mazePixelHeight - camera.h));
 
-    dungeonExit = {exitX * cellSize, exitY * cellSize, cellSize, cellSize};
+    // Projectiles from the previous level don't carry over
+    projectiles.clear();
 
     // Spawn enemies in the dungeon
-    spawnEnemiesInDungeon(difficulty + 1);
+    spawnEnemiesInDungeon(level.enemyCount);
+    snapInterpolation();
+
+    // Build the level after this one while the player clears it
+    levelBuilder.prefetch(difficulty + 1, getLevelSeed());
 }
 
 void Game::spawnEnemiesInDungeon(int numberOfEnemies) {
-    std::vector<std::pair<int, int>> pathCells;
-
-    for (int y = 0; y < dungeonMaze.size(); ++y) {
-        for (int x = 0; x < dungeonMaze[y].size(); ++x) {
-            if (dungeonMaze[y][x] == 0) {
-                pathCells.push_back({x, y});
-            }
-        }
-    }
-
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(pathCells.begin(), pathCells.end(), g);
-
-    for (int i = 0; i < numberOfEnemies && i < pathCells.size(); ++i) {
-        int x = pathCells[i].first;
-        int y = pathCells[i].second;
+    for (int i = 0; i < numberOfEnemies && i < spawnCells.size(); ++i) {
+        int x = spawnCells[i].first;
+        int y = spawnCells[i].second;
 
         float enemyX = x * 96.0f - 32;
         float enemyY = y * 96.0f - 64;
 
-        SDL_Texture* enemyTex = loadTexture(getAssetPath("enemy4.png").c_str());
-        auto enemy = std::make_unique<Enemy>(enemyX, enemyY, enemyTex, 8, 0.1f, pathfindingManager);
+        Enemy* enemy = enemies.get(enemies.emplace(entityStates, enemyX, enemyY, enemySheet, 8, 0.1f, pathfindingManager));
 
         // Set enemy stats based on difficulty
         int additionalHealth = difficulty * 20;       // Increase health by 20 per level
         float additionalSpeed = difficulty * 5.0f;    // Increase speed by 5 per level
         int additionalDamage = difficulty * 5;        // Increase damage by 5 per level
 
+        // Enemies spawned along the last stretch before the exit guard it, with up to half again the health
+        int toExit = levelMetadata.getDistanceToExit(x, y);
+        int routeLength = levelMetadata.getRouteLength();
+        if (toExit >= 0 && toExit < routeLength) {
+            additionalHealth += (Enemy::INITIAL_HEALTH / 2) * (routeLength - toExit) / routeLength;
+        }
+
         enemy->setMaxHealth(Enemy::INITIAL_HEALTH + additionalHealth);
         enemy->setHealth(enemy->getMaxHealth());      // Update current health
         enemy->setMoveSpeed(75.0f + additionalSpeed);
         enemy->setThrustDamage(Enemy::THRUST_DAMAGE + additionalDamage);
         enemy->setSpellDamage(Enemy::SPELL_DAMAGE + additionalDamage);
+    }
+}
 
-        entities.push_back(std::move(enemy));
+void Game::collectSpawnCells(int firstRow) {
+    spawnCells.clear();
+    for (int y = firstRow; y < dungeonMaze.getHeight(); ++y) {
+        for (int x = 0; x < dungeonMaze.getWidth(); ++x) {
+            if (dungeonMaze[y][x] == 0) {
+                spawnCells.push_back({x, y});
+            }
+        }
     }
+    RandomService::stream(RANDOM_SPAWN).shuffle(spawnCells.begin(), spawnCells.end());
+}
+
+void Game::startEndless() {
+    PROFILE_ZONE("Game::startEndless");
+    delete endlessMaze;
+    endlessMaze = new EndlessMaze(ENDLESS_COLUMNS, ENDLESS_WINDOW_CELL_ROWS, getLevelSeed());
+    levelSerial++;
+    endlessMaze->start(dungeonMaze);
+    dungeonMaze[1][1] = 2;
+    dungeonOccluders.setWalls(dungeonMaze, LevelBuilder::TILE_SIZE);
+    pathfindingManager.clear();
+
+    int cellSize = LevelBuilder::TILE_SIZE;
+    player->setX(cellSize + 64);
+    player->setY(cellSize + 64);
+    camera.x = std::max(0, std::min(static_cast<int>(player->getX()) - camera.w / 2 + cellSize / 2, getDungeonWidth() - camera.w));
+    camera.y = std::max(0, static_cast<int>(player->getY()) - camera.h / 2 + cellSize / 2);
+    levelMetadata = LevelMetadata();    // The window keeps changing; the only way on is down
+
+    difficulty = 0;
+    enemies.clear();
+    projectiles.clear();
+    collectSpawnCells(2 * ENDLESS_LOOKAHEAD_CELL_ROWS);    // Not on top of the entrance
+    spawnEnemiesInDungeon(ENDLESS_ENEMIES_PER_SCROLL);
+    snapInterpolation();
+}
+
+void Game::streamEndlessRows() {
+    int playerRow = static_cast<int>(player->getY() + 64) / LevelBuilder::TILE_SIZE;
+    if (playerRow < dungeonMaze.getHeight() - 2 * ENDLESS_LOOKAHEAD_CELL_ROWS) return;
+
+    PROFILE_ZONE("Game::streamEndlessRows");
+    int shiftRows = endlessMaze->scroll(dungeonMaze, ENDLESS_SCROLL_CELL_ROWS);
+    float shift = -static_cast<float>(shiftRows * LevelBuilder::TILE_SIZE);
+
+    // Floating origin: everything moves up with the maze, so coordinates stay
+    // inside the window however deep the descent goes
+    player->translate(0.0f, shift);
+    for (auto& enemy : enemies) {
+        enemy.translate(0.0f, shift);
+        enemy.shiftPath(0, -shiftRows);
+    }
+    enemies.removeIf([](Enemy& enemy) { return enemy.getY() < 0.0f; });   // Left behind in the dropped rows
+    projectiles.translate(0.0f, shift);
+    camera.y += static_cast<int>(shift);
+    previousCamera.y += static_cast<int>(shift);
+
+    pathfindingManager.clear();
+    dungeonOccluders.setWalls(dungeonMaze, LevelBuilder::TILE_SIZE);
+
+    // Fresh rows bring fresh enemies, tougher the deeper they are
+    difficulty = static_cast<int>(endlessMaze->getOriginRow() / (2 * ENDLESS_ROWS_PER_DIFFICULTY));
+    collectSpawnCells(dungeonMaze.getHeight() - shiftRows);
+    spawnEnemiesInDungeon(ENDLESS_ENEMIES_PER_SCROLL);
+}
+
+void Game::stopEndless() {
+    delete endlessMaze;
+    endlessMaze = nullptr;
 }
 
 void Game::enterDungeon() {
     lastPlayerX = player->getX();
     lastPlayerY = player->getY();
     isPlayerInDungeon = true;
-    startLevel(0);
+    if (endlessMode) {
+        startEndless();
+    } else {
+        startLevel(0);
+    }
     
     // Re-initialize the dungeon entrance coordinates to ensure consistency
     std::pair<int, int> entrancePos = findDungeonEntrancePosition();
@@ -601,23 +993,23 @@ bool Game::checkDungeonExit() {
 }
 
 bool Game::checkNextLevelDoor() {
-    // Check if the player is at the bottom-right corner (entrance to the next level)
-    SDL_Rect playerRect = {static_cast<int>(player->getX()), static_cast<int>(player->getY()), 64, 64};
-    SDL_Rect nextLevelRect = {dungeonExit.x, dungeonExit.y, dungeonExit.w - 32, dungeonExit.h - 32};
-    return SDL_HasIntersection(&playerRect, &nextLevelRect);
+    // The cell under the player's feet, as isWall sees it, is the exit to the next level
+    int cellX = static_cast<int>(player->getX() + 32) / LevelBuilder::TILE_SIZE;
+    int cellY = static_cast<int>(player->getY() + 64) / LevelBuilder::TILE_SIZE;
+    return levelMetadata.isExit(cellX, cellY);
 }
 
 void Game::exitDungeon() {
     isPlayerInDungeon = false;
+    stopEndless();
+    projectiles.clear();
+    pathfindingManager.clear();
     difficulty = 0; // Reset difficulty
 
     // Restore player to the last position before entering the dungeon
     player->setX(lastPlayerX);
     player->setY(lastPlayerY + 180);
 
-    delete mazeGenerator;
-    mazeGenerator = nullptr;
-
     // Ensure the entrance remains where it was in the outer world
     std::pair<int, int> entrancePos = findDungeonEntrancePosition();
     int tileSize = 96;
@@ -630,8 +1022,7 @@ void Game::exitDungeon() {
         };
     }
 
-    delete mazeGenerator;
-    mazeGenerator = nullptr;
+    levelBuilder.prefetch(0, getLevelSeed());  // Ready for the next time the dungeon is entered
 
     // Center the camera on the player after exiting the dungeon
     camera.x = player->getX() - camera.w / 2;
@@ -643,6 +1034,7 @@ void Game::exitDungeon() {
 
     camera.x = std::max(0, std::min(camera.x, worldWidth - camera.w));
     camera.y = std::max(0, std::min(camera.y, worldHeight - camera.h));
+    snapInterpolation();
 }
 
 bool Game::isWall(float x, float y) {
@@ -652,42 +1044,44 @@ bool Game::isWall(float x, float y) {
 
     if (isPlayerInDungeon) {
         // Check bounds for dungeon maze
-        if (mazeY < 0 || mazeY >= dungeonMaze.size() || mazeX < 0 || mazeX >= dungeonMaze[0].size()) {
+        if (!dungeonMaze.inBounds(mazeX, mazeY)) {
             return true;
         }
-        return dungeonMaze[mazeY][mazeX] == -1;
+        return dungeonCellDescriptor(dungeonMaze[mazeY][mazeX]).solid;
     } else {
         // Check bounds for outer world map
         if (mazeY < 0 || mazeY >= mapMatrix.size() || mazeX < 0 || mazeX >= mapMatrix[0].size()) {
             return true;
         }
-        return mapMatrix[mazeY][mazeX] == 6; // Fence collision
+        return tileDescriptor(mapMatrix[mazeY][mazeX]).solid;
     }
 }
 
 bool Game::areAllEnemiesCleared() const {
-    for (const auto& entity : entities) {
-        if (dynamic_cast<const Enemy*>(entity.get())) {
-            return false;
-        }
-    }
-    return true;
+    return enemies.empty();
 }
 
 int Game::getDungeonWidth() const {
-    return dungeonMaze.empty() ? 0 : dungeonMaze[0].size() * 96;
+    return dungeonMaze.getWidth() * 96;
 }
 
 int Game::getDungeonHeight() const {
-    return dungeonMaze.size() * 96;
+    return dungeonMaze.getHeight() * 96;
 }
 
 void Game::update() {
+    if (headless) {
+        updateHeadless();
+        return;
+    }
+
+    Uint64 frameStart = SDL_GetPerformanceCounter();
     Uint32 currentTime = SDL_GetTicks();
-    deltaTime = (currentTime - lastTime) / 1000.0f;
+    float frameTime = (currentTime - lastTime) / 1000.0f;
     lastTime = currentTime;
 
     if (isMenuOpen) {
+        accumulator = 0.0f;  // Don't replay the time spent in the menu once it closes
         return;
     }
 
@@ -696,14 +1090,52 @@ void Game::update() {
     pathfindingCv.notify_one(); // Notify pathfinding thread
     playerEnemyActionCv.notify_one();  // Notify player and enemy action thread
 
+    // Run as many fixed steps as the elapsed time covers, but never more than
+    // MAX_CATCHUP_STEPS: after a long stall the simulation slows down instead
+    // of spiralling into ever longer frames
+    accumulator += frameTime;
+    int steps = 0;
+    while (accumulator >= FIXED_TIMESTEP && !isMenuOpen) {
+        if (steps == MAX_CATCHUP_STEPS) {
+            simulationStats.droppedSteps += static_cast<Uint64>(accumulator / FIXED_TIMESTEP);
+            accumulator = std::fmod(accumulator, FIXED_TIMESTEP);
+            break;
+        }
+        step(FIXED_TIMESTEP);
+        accumulator -= FIXED_TIMESTEP;
+        steps++;
+    }
+    renderAlpha = accumulator / FIXED_TIMESTEP;
+
+    world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
+
+    if (steps > 0) {
+        double elapsedMs = (SDL_GetPerformanceCounter() - frameStart) * 1000.0 / SDL_GetPerformanceFrequency();
+        simulationStats.lastFrameSteps = steps;
+        simulationStats.averageStepMs = simulationStats.averageStepMs * 0.9 + (elapsedMs / steps) * 0.1;
+    }
+}
+
+void Game::step(float stepTime) {
+    PROFILE_ZONE("Game::step");
+    deltaTime = stepTime;
+    SimulationClock::advance(stepTime);
+    simulationStats.totalSteps++;
+
+    // Interpolation runs from the state at the start of the step
+    previousCamera = camera;
+    entityStates.savePreviousPositions();  // Player and enemies, one pass over the position arrays
+    projectiles.savePreviousPositions();
+
     if (player->getIsDead()) {
-        player->update(deltaTime, entities, *this);
-        if (isPlayerDeathAnimationFinished() && currentTime - deathTime >= DEATH_DELAY) {
-            menu->setState(Menu::RESPAWN_MENU);
+        player->update(deltaTime, enemies, *this);
+        if (isPlayerDeathAnimationFinished() && SimulationClock::getTicks() - deathTime >= DEATH_DELAY) {
+            if (menu) menu->setState(Menu::RESPAWN_MENU);
             isMenuOpen = true;
         }
     } else {
         processInput();
+        fireProjectiles();
         player->updateCooldowns(deltaTime);
 
         if (!isPlayerInDungeon && checkDungeonEntrance()) {
@@ -713,156 +1145,99 @@ void Game::update() {
                 transitionToNextLevel();
             } else if (checkDungeonExit() && areAllEnemiesCleared()) {
                 exitDungeon();
+            } else if (endlessMaze) {
+                streamEndlessRows();
             }
         }
 
         if (isPlayerInDungeon) {
-            updateSpellAnimation(deltaTime, entities);
-            updateEnemySpellAnimation(deltaTime, entities);
-
-            for (auto& entity : entities) {
-                if (entity->isArrowActive()) {
-                    SDL_Rect arrowRect = entity->getArrowFrame();
-                    arrowRect.x = static_cast<int>(entity->getArrowX());
-                    arrowRect.y = static_cast<int>(entity->getArrowY());
-
-                    for (auto& otherEntity : entities) {
-                        if (otherEntity.get() != entity.get() && Entity::checkCollision(arrowRect, otherEntity->getBoundingBox())) {
-                            if (Enemy* enemy = dynamic_cast<Enemy*>(otherEntity.get())) {
-                                applyDamage(*entity, *enemy, Player::ARROW_DAMAGE);
-                                entity->shootArrow(Entity::Up); // Deactivate the arrow by resetting its position
-                                break;
-                            } else if (Player* player = dynamic_cast<Player*>(otherEntity.get())) {
-                                applyDamage(*entity, *player, Player::ARROW_DAMAGE); // Adjust arrow damage for player if needed
-                                entity->shootArrow(Entity::Up); // Deactivate the arrow by resetting its position
-                                break;
-                            }
-                        }
-                    }
-                    player->updateArrowPosition(deltaTime, dungeonMaze, 96);
-                }
-            }
+            updateProjectiles(deltaTime);
 
-            for (size_t i = 0; i < entities.size(); ++i) {
-                if (entities[i]->isMarkedForRemoval()) continue;
-                for (size_t j = i + 1; j < entities.size(); ++j) {
-                    if (entities[j]->isMarkedForRemoval()) continue;
-
-                    if (Entity::checkCollision(entities[i]->getBoundingBox(), entities[j]->getBoundingBox())) {
-                        if (Player* player = dynamic_cast<Player*>(entities[i].get())) {
-                            if (Enemy* enemy = dynamic_cast<Enemy*>(entities[j].get())) {
-                                resolveCollision(*player, *enemy);
-                            }
-                        } else if (Player* player = dynamic_cast<Player*>(entities[j].get())) {
-                            if (Enemy* enemy = dynamic_cast<Enemy*>(entities[i].get())) {
-                                resolveCollision(*player, *enemy);
-                            }
-                        }
-                    }
-                }
-            }
+            resolvePlayerEnemyCollisions(*player, enemies, *this);
 
             float playerX = player->getX();
             float playerY = player->getY();
             updateCamera(playerX, playerY);
         }
 
-        for (size_t i = 0; i < entities.size(); ++i) {
-            auto& entity = entities[i];
-            if (entity->isMarkedForRemoval()) continue;
-
-            if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                enemy->updateBehavior(deltaTime, *player, entities, *this);
-            } else if (Player* playerEntity = dynamic_cast<Player*>(entity.get())) {
-                playerEntity->update(deltaTime, entities, *this);
+        player->update(deltaTime, enemies, *this);
+        {
+            PROFILE_ZONE("Enemy AI");
+            for (auto& enemy : enemies) {
+                if (enemy.isMarkedForRemoval()) continue;
+                enemy.updateBehavior(deltaTime, *player, *this);
             }
         }
 
         removeDeadEntities();
         updateCamera(player->getX(), player->getY());
-        world->update(camera.x + camera.w / 2, camera.y + camera.h / 2);
     }
 }
 
-void Game::removeDeadEntities() {
-    entities.erase(std::remove_if(entities.begin(), entities.end(),
-                                  [](const std::unique_ptr<Entity>& entity) {
-                                      return entity->isMarkedForRemoval();
-                                  }), entities.end());
+void Game::snapInterpolation() {
+    // After a teleport (level start, leaving the dungeon, respawn) there is nothing to blend from
+    previousCamera = camera;
+    entityStates.savePreviousPositions();
 }
 
-void Game::resolveCollision(Player& player, Enemy& enemy) {
-    SDL_Rect playerBox = player.getBoundingBox();
-    SDL_Rect enemyBox = enemy.getBoundingBox();
+void Game::fireProjectiles() {
+    Entity::Direction arrowDirection;
+    bool arrowRequested = player->takeArrowRequest(arrowDirection);
+    bool spellRequested = player->takeSpellRequest();
 
-    if (Entity::checkCollision(playerBox, enemyBox)) {
-        adjustPositionOnCollision(player, enemy);
-    }
+    // Projectiles only exist inside the dungeon
+    if (!isPlayerInDungeon) return;
 
-    SDL_Rect playerAttackBox = player.getAttackBoundingBox();
-    SDL_Rect enemyAttackBox = enemy.getAttackBoundingBox();
+    if (arrowRequested) {
+        projectiles.fireArrow(*player, arrowDirection, Player::ARROW_DAMAGE);
+    }
+    if (spellRequested) {
+        // Starts above the player's head and homes on the closest enemy
+        float startX = player->getX() + Entity::getFrameWidth() / 2;
+        float startY = player->getY() - 40;
+        projectiles.fireSpell(*player, startX, startY, startX, startY, Player::SPELL_SPEED, Player::SPELL_DURATION, Player::SPELL_DAMAGE, 25);
+    }
 
-    Uint32 currentTime = SDL_GetTicks();
+    for (auto& enemy : enemies) {
+        if (enemy.getAction() != Entity::Spellcasting) continue;
 
-    // Check player's attack collision with enemy
-    if (Entity::checkCollision(playerAttackBox, enemy.getBoundingBox())) {
-        if (player.getAction() == Entity::Thrusting && !player.getDamageApplied() && (currentTime - player.getAttackStartTime() >= player.getAttackDelay())) {
-            applyDamage(player, enemy, Player::THRUST_DAMAGE);
-            player.setDamageApplied(true);
-        } else if (player.getAction() == Entity::Slashing && !player.getDamageApplied() && (currentTime - player.getAttackStartTime() >= player.getAttackDelay())) {
-            applyDamage(player, enemy, Player::SLASH_DAMAGE);
-            player.setDamageApplied(true);
+        if (!projectiles.isAlive(enemy.getCastSpell())) {
+            enemy.setCastSpell(projectiles.fireSpell(enemy, enemy.getX() + Entity::getFrameWidth() / 2, enemy.getY() - 10, player->getX(), player->getY(),
+                                                     Enemy::SPELL_SPEED, Enemy::SPELL_DURATION, enemy.getSpellDamage(), 13));
         }
-    }
 
-    // Check enemy's attack collision with player
-    if (Entity::checkCollision(enemyAttackBox, player.getBoundingBox())) {
-        if (enemy.getAction() == Entity::Thrusting && !enemy.getDamageApplied() && (currentTime - enemy.getAttackStartTime() >= enemy.getAttackDelay())) {
-            applyDamage(enemy, player, enemy.getThrustDamage());
-            enemy.setDamageApplied(true);
-        } else if (enemy.getAction() == Entity::Spellcasting && !enemy.getDamageApplied() && (currentTime - enemy.getAttackStartTime() >= enemy.getAttackDelay())) {
-            applyDamage(enemy, player, enemy.getSpellDamage());
-            enemy.setDamageApplied(true);
+        // Back to walking if the spell could not be cast
+        if (!projectiles.isAlive(enemy.getCastSpell())) {
+            enemy.setAction(Entity::Walking);
         }
     }
 }
 
-void Game::adjustPositionOnCollision(Player& player, Enemy& enemy) {
-    SDL_Rect playerBox = player.getCollisionBoundingBox();
-    SDL_Rect enemyBox = enemy.getCollisionBoundingBox();
+void Game::updateProjectiles(float deltaTime) {
+    PROFILE_ZONE("Game::updateProjectiles");
+    projectileHits.clear();
+    projectiles.update(deltaTime, *player, enemies, dungeonMaze, projectileHits);
 
-    // Calculate the overlap between the player and the enemy
-    int overlapX = (playerBox.x + playerBox.w / 2) - (enemyBox.x + enemyBox.w / 2);
-    int overlapY = (playerBox.y + playerBox.h / 2) - (enemyBox.y + enemyBox.h / 2);
-
-    int halfWidth = (playerBox.w + enemyBox.w) / 2;
-    int halfHeight = (playerBox.h + enemyBox.h) / 2;
-
-    if (abs(overlapX) < halfWidth && abs(overlapY) < halfHeight) {
-        int offsetX = halfWidth - abs(overlapX);
-        int offsetY = halfHeight - abs(overlapY);
-
-        // Resolve collision by adjusting positions based on the overlap amount
-        if (offsetX < offsetY) {
-            if (overlapX > 0) {
-                player.setX(player.getX() + offsetX);
-                enemy.setX(enemy.getX() - offsetX);
+    for (const ProjectileHit& hit : projectileHits) {
+        if (hit.owner == Entity::PlayerEntity) {
+            if (hit.kind == Projectile::Arrow) {
+                applyDamage(*player, *hit.target, hit.damage);
             } else {
-                player.setX(player.getX() - offsetX);
-                enemy.setX(enemy.getX() + offsetX);
+                hit.target->takeDamage(hit.damage);  // Marks the enemy for removal when it dies
             }
         } else {
-            if (overlapY > 0) {
-                player.setY(player.getY() + offsetY);
-                enemy.setY(enemy.getY() - offsetY);
-            } else {
-                player.setY(player.getY() - offsetY);
-                enemy.setY(enemy.getY() + offsetY);
+            player->takeDamage(hit.damage);
+            if (!player->isAlive()) {
+                player->setIsDead(true);
             }
         }
     }
 }
 
+void Game::removeDeadEntities() {
+    enemies.removeIf([](const Enemy& enemy) { return enemy.isMarkedForRemoval(); });
+}
+
 bool Game::isPlayerDeathAnimationFinished() const {
     return player->getIsDead() && player->isDeathAnimationFinished();
 }
@@ -899,7 +1274,7 @@ void Game::applyDamage(Entity& attacker, Entity& target, int damage) {
     // Check if the target is facing the attacker
     if (isFacing(target, attacker)) {
         float dodgeChance = 0.2f;
-        if (static_cast<float>(rand()) / static_cast<float>(RAND_MAX) < dodgeChance) {
+        if (RandomService::stream(RANDOM_COMBAT).nextFloat() < dodgeChance) {
             // Dodge successful
             return;
         }
@@ -910,12 +1285,10 @@ void Game::applyDamage(Entity& attacker, Entity& target, int damage) {
     
     // Handle target death
     if (!target.isAlive()) {
-        if (Player* player = dynamic_cast<Player*>(&target)) {
+        if (target.getType() == Entity::PlayerEntity) {
             player->setIsDead(true);
-            deathTime = SDL_GetTicks();
-        } else if (Enemy* enemy = dynamic_cast<Enemy*>(&target)) {
-            entitiesToRemove.push_back(&target);
-
+            deathTime = SimulationClock::getTicks();
+        } else if (target.getType() == Entity::EnemyEntity) {
             int healAmount = 10 + difficulty * 5;  // Heal increases by 5 per level
             player->heal(healAmount);
         }
@@ -943,102 +1316,58 @@ bool Game::isFacing(Entity& entity, Entity& target) {
     }
 }
 
-void Game::updateSpellAnimation(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities) {
-    if (player->getAction() == Entity::Spellcasting && !player->isArrowActive()) {
-        // Find the closest enemy
-        Enemy* closestEnemy = nullptr;
-        float minDistance = std::numeric_limits<float>::max();
-
-        for (const auto& entity : entities) {
-            if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                float distance = std::hypot(player->getX() - enemy->getX(), player->getY() - enemy->getY());
-                if (distance < minDistance) {
-                    minDistance = distance;
-                    closestEnemy = enemy;
-                }
-            }
-        }
+void Game::loadAtlas() {
+    atlas = new TextureAtlas(renderer);
+    atlas->add("tileset", getAssetPath("tileset.png"));
+    atlas->add("dungeon_entrance", getAssetPath("dungeon_entrance.png"));
+    atlas->add("path_tile", getAssetPath("cobblestone_2.png"));
+    atlas->add("wall_tile", getAssetPath("Brickwall_Texture.png"));
+    atlas->add("hud", getAssetPath("hud.png"));
 
-        if (closestEnemy) {
-            // Set the spell direction towards the closest enemy
-            player->setSpellTarget(closestEnemy->getX(), closestEnemy->getY());
-        }
+    if (!atlas->build()) {
+        printf("Failed to build the texture atlas!\n");
+        isRunning = false;
     }
-
-    // Update spell position
-    player->updateSpellPosition(deltaTime, entities, *this);
 }
 
-void Game::loadHUDTexture() {
-    hudTexture = loadTexture(getAssetPath("hud.png").c_str());
-}
-
-void drawRoundedRect(SDL_Renderer* renderer, SDL_Rect rect, int radius, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+void drawRoundedRect(SpriteBatch& batch, SDL_Rect rect, int radius, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     int x = rect.x;
     int y = rect.y;
     int w = rect.w;
     int h = rect.h;
-
-    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_Color color = {r, g, b, a};
 
     // Draw the center rectangle
-    SDL_Rect centerRect = { x + radius, y, w - 2 * radius, h };
-    SDL_RenderFillRect(renderer, &centerRect);
+    batch.fillRect({ x + radius, y, w - 2 * radius, h }, color, LAYER_HUD_OVERLAY);
 
     // Draw the side rectangles
-    SDL_Rect leftRect = { x, y + radius, radius, h - 2 * radius };
-    SDL_Rect rightRect = { x + w - radius, y + radius, radius, h - 2 * radius };
-    SDL_RenderFillRect(renderer, &leftRect);
-    SDL_RenderFillRect(renderer, &rightRect);
-
-    // Draw the corners
-    for (int woff = 0; woff < radius; woff++) {
-        for (int hoff = 0; hoff < radius; hoff++) {
-            if ((woff * woff + hoff * hoff) <= (radius * radius)) {
-                SDL_RenderDrawPoint(renderer, x + radius - woff, y + radius - hoff);
-                SDL_RenderDrawPoint(renderer, x + w - radius + woff, y + radius - hoff);
-                SDL_RenderDrawPoint(renderer, x + radius - woff, y + h - radius + hoff);
-                SDL_RenderDrawPoint(renderer, x + w - radius + woff, y + h - radius + hoff);
-            }
+    batch.fillRect({ x, y + radius, radius, h - 2 * radius }, color, LAYER_HUD_OVERLAY);
+    batch.fillRect({ x + w - radius, y + radius, radius, h - 2 * radius }, color, LAYER_HUD_OVERLAY);
+
+    // Draw the corners, one horizontal span per row instead of per pixel
+    for (int hoff = 0; hoff < radius; hoff++) {
+        int span = 0;
+        while (span + 1 < radius && (span + 1) * (span + 1) + hoff * hoff <= radius * radius) {
+            span++;
         }
+        batch.fillRect({ x + radius - span, y + radius - hoff, span + 1, 1 }, color, LAYER_HUD_OVERLAY);
+        batch.fillRect({ x + w - radius, y + radius - hoff, span + 1, 1 }, color, LAYER_HUD_OVERLAY);
+        batch.fillRect({ x + radius - span, y + h - radius + hoff, span + 1, 1 }, color, LAYER_HUD_OVERLAY);
+        batch.fillRect({ x + w - radius, y + h - radius + hoff, span + 1, 1 }, color, LAYER_HUD_OVERLAY);
     }
 }
 
 void Game::renderText(const char* text, int x, int y, SDL_Color color) {
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text, color);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-
-    SDL_Rect dstRect = { x, y, surface->w, surface->h };
-    SDL_RenderCopy(renderer, texture, NULL, &dstRect);
-
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+    if (textRenderer) {
+        textRenderer->drawText(*spriteBatch, text, x, y, color, LAYER_TEXT);
+    }
 }
 
 void Game::renderSmallText(const char* text, int x, int y, SDL_Color color) {
-    // Render the outline first
     SDL_Color outlineColor = {0, 0, 0, 255}; // Black color for outline
-    for (int dx = -1; dx <= 1; ++dx) {
-        for (int dy = -1; dy <= 1; ++dy) {
-            if (dx != 0 || dy != 0) {
-                SDL_Surface* outlineSurface = TTF_RenderText_Solid(smallFont, text, outlineColor);
-                SDL_Texture* outlineTexture = SDL_CreateTextureFromSurface(renderer, outlineSurface);
-                SDL_Rect outlineRect = { x + dx, y + dy, outlineSurface->w, outlineSurface->h };
-                SDL_RenderCopy(renderer, outlineTexture, NULL, &outlineRect);
-                SDL_FreeSurface(outlineSurface);
-                SDL_DestroyTexture(outlineTexture);
-            }
-        }
+    if (smallTextRenderer) {
+        smallTextRenderer->drawOutlinedText(*spriteBatch, text, x, y, color, outlineColor, LAYER_TEXT);
     }
-
-    // Render the main text
-    SDL_Surface* surface = TTF_RenderText_Solid(smallFont, text, color);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect dstRect = { x, y, surface->w, surface->h };
-    SDL_RenderCopy(renderer, texture, NULL, &dstRect);
-
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
 }
 
 void Game::renderCooldowns() {
@@ -1081,6 +1410,7 @@ void Game::renderCooldowns() {
 }
 
 void Game::renderHUD() {
+    PROFILE_ZONE("Game::renderHUD");
     // Define the source rectangles for player HUD and ability HUD within the texture
     SDL_Rect playerHudSourceRect = { 0, 0, 550, 85 }; // Coordinates and size of the player HUD in the texture
     SDL_Rect abilityHudSourceRect = { 0, 80, 250, 150 }; // Coordinates and size of the ability HUD in the texture
@@ -1104,7 +1434,8 @@ void Game::renderHUD() {
     SDL_Rect abilityHudDestRect = { abilityHudX, abilityHudY, abilityHudWidth, abilityHudHeight };
 
     // Render player HUD
-    SDL_RenderCopy(renderer, hudTexture, &playerHudSourceRect, &playerHudDestRect);
+    SDL_Rect hudRegion = atlas->getRegion("hud");
+    spriteBatch->draw(atlas->getTexture(), TextureAtlas::subRect(hudRegion, playerHudSourceRect), playerHudDestRect, LAYER_HUD);
 
     // Render player's health in the HUD
     int healthBarX = playerHudX + 132;
@@ -1115,14 +1446,14 @@ void Game::renderHUD() {
     if (healthRatio > 0) {
         SDL_Rect healthRect = { healthBarX, healthBarY, static_cast<int>(healthBarWidth * healthRatio), healthBarHeight };
         // Draw the health bar with rounded corners and slightly whiter red color
-        drawRoundedRect(renderer, healthRect, 5, 255, 60, 60, 255); // Rounded corners with radius 5
+        drawRoundedRect(*spriteBatch, healthRect, 5, 255, 60, 60, 255); // Rounded corners with radius 5
     }
 
     // Render the green bar (placeholder)
     int greenBarX = playerHudX + 132;
     int greenBarY = playerHudY + 61;
     SDL_Rect greenRect = { greenBarX, greenBarY, healthBarWidth, healthBarHeight };
-    drawRoundedRect(renderer, greenRect, 5, 34, 177, 76, 255); // Rounded corners with radius 5, green color
+    drawRoundedRect(*spriteBatch, greenRect, 5, 34, 177, 76, 255); // Rounded corners with radius 5, green color
 
     // Render the stamina bar (blue)
     int blueBarX = playerHudX + 132;
@@ -1131,13 +1462,77 @@ void Game::renderHUD() {
     int blueBarWidth = static_cast<int>(healthBarWidth * staminaRatio);
     if (blueBarWidth > 4.75) {
         SDL_Rect blueRect = { blueBarX, blueBarY, blueBarWidth, healthBarHeight };
-        drawRoundedRect(renderer, blueRect, 5, 0, 162, 232, 255); // Rounded corners with radius 5, blue color
+        drawRoundedRect(*spriteBatch, blueRect, 5, 0, 162, 232, 255); // Rounded corners with radius 5, blue color
     }
 
     // Render ability HUD
-    SDL_RenderCopy(renderer, hudTexture, &abilityHudSourceRect, &abilityHudDestRect);
+    spriteBatch->draw(atlas->getTexture(), TextureAtlas::subRect(hudRegion, abilityHudSourceRect), abilityHudDestRect, LAYER_HUD);
 
     renderCooldowns();
+
+    if (perfOverlay.isVisible()) {
+        renderPerfOverlay();
+    }
+}
+
+void Game::renderPerfOverlay() {
+    if (!smallTextRenderer) return;
+    perfOverlay.sampleFrame();
+
+    // Figures describe the last finished frame; formatted into a fixed buffer
+    // and drawn without the layout cache so the overlay itself allocates nothing
+    const ProfileFrame& frame = Profiler::getLastFrame();
+    int lights = isPlayerInDungeon ? lightingManager->getLastLightCount() : 0;
+    size_t entities = 1 + enemies.size() + projectiles.size();
+    size_t chunks = world ? world->getChunkStats().loadedChunks : 0;
+    unsigned long lookups = pathfindingManager.getLookups();
+    double pathHitRate = lookups ? 100.0 * pathfindingManager.getCacheHits() / lookups : 0.0;
+
+    int x = 1920 - 470;
+    int y = 10;
+    const int lineHeight = 22;
+    SDL_Rect background = {x - 10, y - 6, 460, lineHeight * 7 + 12};
+    spriteBatch->fillRect(background, {0, 0, 0, 170}, LAYER_HUD_OVERLAY);
+
+    SDL_Color color = {255, 255, 255, 255};
+    char line[128];
+
+    snprintf(line, sizeof(line), "FPS %.1f   frame p50 %.2f  p95 %.2f  p99 %.2f ms",
+             perfOverlay.getAverageFps(), perfOverlay.getPercentileMs(50), perfOverlay.getPercentileMs(95), perfOverlay.getPercentileMs(99));
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "step %.2f  ai %.2f  collision %.2f  projectiles %.2f ms",
+             Profiler::getZoneMs("Game::step"), Profiler::getZoneMs("Enemy AI"),
+             Profiler::getZoneMs("Collision"), Profiler::getZoneMs("Game::updateProjectiles"));
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "world %.2f  dungeon %.2f  lighting %.2f ms",
+             Profiler::getZoneMs("World::update") + Profiler::getZoneMs("World::render"),
+             Profiler::getZoneMs("Dungeon draw"), Profiler::getZoneMs("LightingManager::renderLighting"));
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "batch flush %.2f  hud %.2f  present %.2f ms",
+             Profiler::getZoneMs("SpriteBatch::flush"), Profiler::getZoneMs("Game::renderHUD"),
+             Profiler::getZoneMs("SDL_RenderPresent"));
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "draw calls %u  lights %d  entities %zu  chunks %zu",
+             frame.counters[COUNTER_DRAW_CALLS], lights, entities, chunks);
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "A* expansions %u  path cache %.0f%% of %lu",
+             frame.counters[COUNTER_ASTAR_EXPANSIONS], pathHitRate, lookups);
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "steps %d  dropped %llu",
+             simulationStats.lastFrameSteps, static_cast<unsigned long long>(simulationStats.droppedSteps));
+    smallTextRenderer->drawTransientText(*spriteBatch, line, x, y, color, LAYER_TEXT);
 }
 
 void Game::renderHealthBar(int x, int y, int currentHealth, int maxHealth) {
@@ -1147,30 +1542,64 @@ void Game::renderHealthBar(int x, int y, int currentHealth, int maxHealth) {
 
     // Draw the background (black)
     SDL_Rect backgroundRect = { x, y, barWidth, barHeight };
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderFillRect(renderer, &backgroundRect);
+    spriteBatch->fillRect(backgroundRect, {0, 0, 0, 255}, LAYER_OVERLAY);
 
     // Draw the health bar (red)
     SDL_Rect healthRect = { x, y, static_cast<int>(barWidth * healthRatio), barHeight };
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_RenderFillRect(renderer, &healthRect);
+    spriteBatch->fillRect(healthRect, {255, 0, 0, 255}, LAYER_OVERLAY);
+}
+
+SDL_Rect Game::renderEntity(Entity& entity) {
+    SDL_Rect srcRect = toSDLRect(entity.getCurrentFrame());
+    SDL_Rect destRect = { 
+        static_cast<int>(entity.getRenderX(renderAlpha)) - camera.x, 
+        static_cast<int>(entity.getRenderY(renderAlpha)) - camera.y, 
+        static_cast<int>(srcRect.w * 2),  
+        static_cast<int>(srcRect.h * 2)  
+    };
+    spriteBatch->draw(getSpriteSheetTexture(entity.getSpriteSheet()), srcRect, destRect, LAYER_ENTITIES);
+    return destRect;
+}
+
+SDL_Rect Game::getProjectileRect(const Projectile& projectile) const {
+    return {
+        static_cast<int>(projectile.prevX + (projectile.x - projectile.prevX) * renderAlpha) - camera.x,
+        static_cast<int>(projectile.prevY + (projectile.y - projectile.prevY) * renderAlpha) - camera.y,
+        64, // Width of the projectile frame
+        64  // Height of the projectile frame
+    };
 }
 
 void Game::render() {
+    PROFILE_ZONE("Game::render");
     std::lock_guard<std::mutex> dungeonLock(dungeonMutex);  // Lock dungeon rendering
     std::lock_guard<std::mutex> lightingLock(lightingMutex); // Lock lighting rendering
     std::lock_guard<std::mutex> entityLock(entityMutex); // Lock entity rendering
 
     SDL_RenderClear(renderer);
 
+    // Draw from a view blended between the last two simulation steps;
+    // the simulation's own camera is restored once the frame is drawn
+    SDL_Rect simulationCamera = camera;
+    float simulationAlpha = renderAlpha;
+    if (!interpolateRendering) renderAlpha = 1.0f;
+    camera.x = previousCamera.x + static_cast<int>(std::lround((camera.x - previousCamera.x) * renderAlpha));
+    camera.y = previousCamera.y + static_cast<int>(std::lround((camera.y - previousCamera.y) * renderAlpha));
+
     std::vector<SDL_Rect> enemyPositions;
     std::vector<SDL_Rect> spellPositions;
 
     if (isPlayerInDungeon) {
+        PROFILE_ZONE("Dungeon draw");
+
         // Render the dungeon background and tiles first
         int cellSize = 96; // Adjust cell size as needed
-        for (int y = 0; y < dungeonMaze.size(); ++y) {
-            for (int x = 0; x < dungeonMaze[y].size(); ++x) {
+        SDL_Texture* atlasTexture = atlas->getTexture();
+        SDL_Rect regions[DUNGEON_REGION_COUNT];
+        regions[DUNGEON_REGION_WALL] = atlas->getRegion("wall_tile");
+        regions[DUNGEON_REGION_PATH] = atlas->getRegion("path_tile");
+        for (int y = 0; y < dungeonMaze.getHeight(); ++y) {
+            for (int x = 0; x < dungeonMaze.getWidth(); ++x) {
                 SDL_Rect cellRect = {
                     x * cellSize - camera.x,
                     y * cellSize - camera.y,
@@ -1178,105 +1607,60 @@ void Game::render() {
                     cellSize
                 };
 
-                if (dungeonMaze[y][x] == -1) {
-                    SDL_RenderCopy(renderer, wallTileTexture, NULL, &cellRect);
-                } else if (dungeonMaze[y][x] == 0) {
-                    SDL_RenderCopy(renderer, pathTileTexture, NULL, &cellRect);
-                } else if (dungeonMaze[y][x] == 2) {
-                    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255); // Blue color for spawn/exit point
-                    SDL_RenderFillRect(renderer, &cellRect);
-                } else if (dungeonMaze[y][x] == 3) {
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red color for next level entrance
-                    SDL_RenderFillRect(renderer, &cellRect);
+                const DungeonCellDescriptor& cell = dungeonCellDescriptor(dungeonMaze[y][x]);
+                if (cell.region != DUNGEON_REGION_NONE) {
+                    spriteBatch->draw(atlasTexture, regions[cell.region], cellRect, LAYER_GROUND);
+                } else {
+                    spriteBatch->fillRect(cellRect, {cell.color[0], cell.color[1], cell.color[2], 255}, LAYER_GROUND);
                 }
             }
         }
 
         // Collect enemy and spell positions for lighting effects
-        for (const auto& entity : entities) {
-            if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                SDL_Rect enemyRect = {
-                    static_cast<int>(enemy->getX()) - camera.x,
-                    static_cast<int>(enemy->getY()) - camera.y,
-                    static_cast<int>(enemy->getCurrentFrame().w * 2),
-                    static_cast<int>(enemy->getCurrentFrame().h * 2)
-                };
-                enemyPositions.push_back(enemyRect);
-            }
-
-            if (entity->isSpellActive()) {
-                SDL_Rect spellRect = {
-                    static_cast<int>(entity->getSpellX()) - camera.x,
-                    static_cast<int>(entity->getSpellY()) - camera.y,
-                    64, // Width of the spell texture
-                    64  // Height of the spell texture
-                };
-                spellPositions.push_back(spellRect);
-            }
+        for (auto& enemy : enemies) {
+            SDL_Rect enemyRect = {
+                static_cast<int>(enemy.getRenderX(renderAlpha)) - camera.x,
+                static_cast<int>(enemy.getRenderY(renderAlpha)) - camera.y,
+                static_cast<int>(enemy.getCurrentFrame().w * 2),
+                static_cast<int>(enemy.getCurrentFrame().h * 2)
+            };
+            enemyPositions.push_back(enemyRect);
         }
 
         // Render main entities (Player, Enemies)
-        for (const auto& entity : entities) {
-            SDL_Rect srcRect = entity->getCurrentFrame();
-            SDL_Rect destRect = { 
-                static_cast<int>(entity->getX()) - camera.x, 
-                static_cast<int>(entity->getY()) - camera.y, 
-                static_cast<int>(srcRect.w * 2),  
-                static_cast<int>(srcRect.h * 2)  
-            };
-            SDL_RenderCopy(renderer, entity->getTex(), &srcRect, &destRect);
-
-            // Render spells
-            if (entity->isSpellActive()) {
-                SDL_Rect spellSrcRect;
-                if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                    spellSrcRect = enemy->getSpellFrameForEnemy();
-                } else {
-                    spellSrcRect = entity->getSpellFrame();
-                }
-
-                SDL_Rect spellDestRect = {
-                    static_cast<int>(entity->getSpellX()) - camera.x,
-                    static_cast<int>(entity->getSpellY()) - camera.y,
-                    64,
-                    64
-                };
-                SDL_RenderCopy(renderer, entity->getTex(), &spellSrcRect, &spellDestRect);
-            }
-
-            // Render health bar above the entity if it's an enemy
-            if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get())) {
-                int healthBarX = destRect.x;
-                int healthBarY = destRect.y - 10; // Adjust the Y position to be above the enemy
-                renderHealthBar(healthBarX, healthBarY, enemy->getHealth(), enemy->getMaxHealth());
-            }
+        renderEntity(*player);
+        for (auto& enemy : enemies) {
+            SDL_Rect destRect = renderEntity(enemy);
+
+            // Render health bar above the enemy
+            int healthBarX = destRect.x;
+            int healthBarY = destRect.y - 10; // Adjust the Y position to be above the enemy
+            renderHealthBar(healthBarX, healthBarY, enemy.getHealth(), enemy.getMaxHealth());
         }
 
-        // Render arrows
-        for (const auto& entity : entities) {
-            if (entity->isArrowActive()) {
-                SDL_Rect arrowSrcRect = entity->getArrowFrame();
-                SDL_Rect arrowDestRect = {
-                    static_cast<int>(entity->getArrowX()) - camera.x,
-                    static_cast<int>(entity->getArrowY()) - camera.y,
-                    64,
-                    64
-                };
-                SDL_RenderCopy(renderer, entity->getTex(), &arrowSrcRect, &arrowDestRect);
+        // Render spells and arrows
+        for (size_t i = 0; i < projectiles.size(); ++i) {
+            const Projectile& projectile = projectiles.get(i);
+            SDL_Rect destRect = getProjectileRect(projectile);
+            spriteBatch->draw(getSpriteSheetTexture(projectile.spriteSheet), toSDLRect(ProjectileSystem::getFrame(projectile)), destRect, LAYER_EFFECTS);
+            if (projectile.kind == Projectile::Spell) {
+                spellPositions.push_back(destRect);
             }
         }
 
+        spriteBatch->flush();  // Lighting is composited over everything drawn so far
+
         // Apply lighting effects for player, enemies, and spells
         lightingManager->renderLighting(
             {
-                static_cast<int>(player->getX()), 
-                static_cast<int>(player->getY()), 
+                static_cast<int>(player->getRenderX(renderAlpha)), 
+                static_cast<int>(player->getRenderY(renderAlpha)), 
                 player->getCurrentFrame().w * 2, 
                 player->getCurrentFrame().h * 2
             },
             enemyPositions,
             spellPositions,
-            dungeonMaze,
+            dungeonOccluders,
             camera
         );
 
@@ -1288,49 +1672,57 @@ void Game::render() {
             isPlayerInDungeon, 
             dungeonEntrance, 
             camera, 
-            dungeonEntranceTexture, 
-            tilesetTexture
+            *spriteBatch, 
+            *atlas
         );
 
         // Render entities (Player, Enemies, etc.)
-        for (const auto& entity : entities) {
-            SDL_Rect srcRect = entity->getCurrentFrame();
-            SDL_Rect destRect = { 
-                static_cast<int>(entity->getX()) - camera.x, 
-                static_cast<int>(entity->getY()) - camera.y, 
-                static_cast<int>(srcRect.w * 2),  
-                static_cast<int>(srcRect.h * 2)  
-            };
-            SDL_RenderCopy(renderer, entity->getTex(), &srcRect, &destRect);
+        renderEntity(*player);
+        for (auto& enemy : enemies) {
+            renderEntity(enemy);
         }
+
+        spriteBatch->flush();
     }
 
     // Render HUD
     renderHUD();
+    spriteBatch->flush();
 
     // Render menu if open
     if (isMenuOpen) {
         menu->render();
+        spriteBatch->flush();  // Button labels
     }
 
-    SDL_RenderPresent(renderer);
-}
-
-void Game::clean() {
-    for (auto& entity : entities) {
-        entity.reset();
+    {
+        PROFILE_ZONE("SDL_RenderPresent");
+        SDL_RenderPresent(renderer);
     }
-    entities.clear();
 
-    if (spriteSheet) {
-        SDL_DestroyTexture(spriteSheet);
-        spriteSheet = nullptr;
-    }
+    camera = simulationCamera;
+    renderAlpha = simulationAlpha;
+}
 
-    if (hudTexture) {
-        SDL_DestroyTexture(hudTexture);
-        hudTexture = nullptr;
-    }
+void Game::clean() {
+    stopEndless();
+    enemies.clear();
+    projectiles.clear();
+    delete player;
+    player = nullptr;
+
+    spriteSheets.clear();
+    delete textureCache;
+    textureCache = nullptr;
+    delete spriteBatch;
+    spriteBatch = nullptr;
+    delete atlas;
+    atlas = nullptr;
+
+    delete textRenderer;
+    textRenderer = nullptr;
+    delete smallTextRenderer;
+    smallTextRenderer = nullptr;
 
     if (font) {
         TTF_CloseFont(font);
@@ -1342,16 +1734,6 @@ void Game::clean() {
         smallFont = nullptr;
     }
 
-    if (pathTileTexture) {
-        SDL_DestroyTexture(pathTileTexture);
-        pathTileTexture = nullptr;
-    }
-
-    if (wallTileTexture) {
-        SDL_DestroyTexture(wallTileTexture);
-        wallTileTexture = nullptr;
-    }
-
     delete menu;
     menu = nullptr;
     delete world;
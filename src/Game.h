@@ -12,31 +12,77 @@
 #include "Entity.h"
 #include "Player.h"
 #include "Enemy.h"
+#include "SlotMap.h"
+#include "ProjectileSystem.h"
+#include "Collision.h"
 #include "Menu.h"
 #include "World.h"
-#include "MazeGenerator.h"
+#include "LevelBuilder.h"
+#include "EndlessMaze.h"
 #include "PathfindingManager.h"
 #include "LightingManager.h"
 #include "GameMap.h"
+#include "TileTypes.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+#include "TextRenderer.h"
+#include "SpriteBatch.h"
+#include "Clock.h"
+#include "Random.h"
+#include "InputLog.h"
+#include "Profiler.h"
+#include "PerfOverlay.h"
+#include "Scenario.h"
+
+#include "SimulationContext.h"
 
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <condition_variable>
 
-class Game {
+struct SimulationStats {
+    Uint64 totalSteps;
+    Uint64 droppedSteps;        // Steps skipped because a frame hit MAX_CATCHUP_STEPS
+    int lastFrameSteps;
+    double averageStepMs;       // Smoothed cost of one simulation step, rendering excluded
+};
+
+struct HeadlessStats {
+    int levelsCompleted;
+    int levelsCleared;          // Completed by killing every enemy rather than timing out
+    int deaths;
+};
+
+// Simulation code works in plain Rects; the renderer converts them at the SDL boundary
+inline SDL_Rect toSDLRect(const Rect& rect) {
+    return {rect.x, rect.y, rect.w, rect.h};
+}
+
+class Game : public SimulationContext {
 public:
+    static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+    static const int MAX_CATCHUP_STEPS = 5;
+
     Game();
     ~Game();
 
     void init(const char* title, int width, int height, bool fullscreen);
+    void initHeadless();            // No window, renderer, textures or fonts
+    void runHeadless(int levels);   // Simulate levels back to back at full speed
+    void startRecording(const std::string& path);
+    void stopRecording();
+    void runReplay(const InputLog& log, const std::string& timingPath);
+    bool runScenario(const std::string& name, int frames, ScenarioResult& result);  // False if the name is unknown
     void handleEvents();
+    void handleEvent(const SDL_Event& event);
     void update();
+    void step(float stepTime);  // One fixed simulation step, no rendering
     void render();
     void clean();
     bool running() { return isRunning; }
     void resetGame(bool resetDungeon = true);
-    void applyDamage(Entity& attacker, Entity& target, int damage);
+    void applyDamage(Entity& attacker, Entity& target, int damage) override;
     bool isPlayerDeathAnimationFinished() const;
     void removeDeadEntities();
     void updateCamera(float playerX, float playerY);
@@ -47,7 +93,8 @@ public:
     void transitionToNextLevel();
     bool checkNextLevelDoor();
     void startLevel(int difficulty);
-    bool isWall(float x, float y);
+    void setEndlessMode(bool enabled) { endlessMode = enabled; }
+    bool isWall(float x, float y) override;
     int getDungeonWidth() const;
     int getDungeonHeight() const;
     void renderText(const char* text, int x, int y, SDL_Color color);
@@ -65,26 +112,53 @@ public:
     SDL_Window* window;
     SDL_Renderer* renderer;
 
-    const std::vector<std::vector<int>>& getDungeonMaze() const { return dungeonMaze; }
+    const Grid<int>& getDungeonMaze() const override { return dungeonMaze; }
+
+    SimulationStats getSimulationStats() const { return simulationStats; }
+    void setInterpolation(bool enabled) { interpolateRendering = enabled; }
 
 private:
     Uint32 lastTime;
-    float deltaTime;
+    float deltaTime;            /* Always FIXED_TIMESTEP inside a step */
+    float accumulator;          /* Real time not yet consumed by simulation steps */
+    float renderAlpha;          /* How far between the last two steps the frame is drawn */
+    bool interpolateRendering;
+    SDL_Rect previousCamera;
+    SimulationStats simulationStats;
+    void snapInterpolation();
+
+    bool headless;
+    HeadlessStats headlessStats;
+    Uint32 headlessLevelStart;
+    static const Uint32 HEADLESS_LEVEL_TIME = 20000;    /* Simulated ms before a level is skipped */
+    static const int HEADLESS_MAX_DIFFICULTY = 10;
+    void updateHeadless();
+    void driveHeadlessPlayer();
+    static const int SCENARIO_WARMUP_FRAMES = 60;       /* Untimed frames before a scenario is measured */
+    static constexpr float SCENARIO_WALK_SPEED = 800.0f;  /* Pixels per second, so a run crosses several chunks */
+
+    Uint8 keyState[SDL_NUM_SCANCODES];  /* Held keys as seen through handled events, so replays move the player too */
+    bool recording;
+    std::string recordingPath;
+    InputLog inputLog;
 
     Uint32 deathTime;
     const Uint32 DEATH_DELAY = 2000;
 
-    std::vector<Entity*> entitiesToRemove;
-    std::vector<std::unique_ptr<Entity>> entities;
-
-    SDL_Texture* loadTexture(const char* fileName);
-    SDL_Texture* spriteSheet;
-    void loadHUDTexture();
-    SDL_Texture* hudTexture;
-    SDL_Texture* pathTileTexture;
-    SDL_Texture* wallTileTexture;
-    SDL_Texture* dungeonEntranceTexture;
-    SDL_Texture* tilesetTexture;
+    EntityStates entityStates;      /* Positions and health of the player and every enemy; outlives them all */
+    SlotMap<Enemy> enemies;         /* Enemies stored contiguously; the player is owned separately */
+    ProjectileSystem projectiles;   /* Every arrow and spell in flight, player's and enemies' */
+    std::vector<ProjectileHit> projectileHits;
+    void fireProjectiles();
+    void updateProjectiles(float deltaTime);
+
+    TextureCache* textureCache;     /* Entity sprite sheets, loaded once and shared */
+    std::vector<std::shared_ptr<SDL_Texture>> spriteSheets;   /* Indexed by SpriteSheetId */
+    SpriteSheetId loadSpriteSheet(const std::string& file);
+    SDL_Texture* getSpriteSheetTexture(SpriteSheetId sheet) const;
+    void loadAtlas();
+    TextureAtlas* atlas;            /* Tiles, dungeon floor, entrance and HUD packed into one texture */
+    SpriteBatch* spriteBatch;
 
     Player* player;
     Menu* menu;
@@ -95,13 +169,12 @@ private:
     void handleWallSliding(const Uint8* state, float playerLeft, float playerRight, float playerTop, float playerBottom);
 
     void spawnEnemy();
-    void resolveCollision(Player& player, Enemy& enemy);
-    void adjustPositionOnCollision(Player& player, Enemy& enemy);
     void renderHealthBar(int x, int y, int currentHealth, int maxHealth);
-    void updateSpellAnimation(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities);
-    void updateEnemySpellAnimation(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities);
+    SDL_Rect renderEntity(Entity& entity);
+    SDL_Rect getProjectileRect(const Projectile& projectile) const;
     void renderHUD();
     void renderCooldowns();
+    void renderPerfOverlay();
     void renderSmallText(const char* text, int x, int y, SDL_Color color);
     bool isFacing(Entity& entity, Entity& target);
     void spawnEnemiesInDungeon(int numberOfEnemies);
@@ -111,14 +184,35 @@ private:
 
     TTF_Font* font;
     TTF_Font* smallFont;
+    TextRenderer* textRenderer;
+    TextRenderer* smallTextRenderer;   /* Outlined, for keybind labels */
+    PerfOverlay perfOverlay;           /* Frame times and subsystem costs, toggled with F3 */
 
     bool isPlayerInDungeon;
     SDL_Rect dungeonEntrance;
-    SDL_Rect dungeonExit;
     float lastPlayerX, lastPlayerY;
 
-    MazeGenerator* mazeGenerator;
-    std::vector<std::vector<int>> dungeonMaze;
+    LevelBuilder levelBuilder;          /* Builds the next level in the background while this one is played */
+    uint64_t levelSerial;               /* Levels started so far; picks each level's seed */
+    uint64_t getLevelSeed() const { return RandomService::deriveSeed(RANDOM_MAZE, levelSerial); }
+    Grid<int> dungeonMaze;
+    LightGeometry dungeonOccluders;     /* Wall grid of dungeonMaze for the lighting rays */
+    std::vector<std::pair<int, int>> spawnCells;
+    LevelMetadata levelMetadata;        /* Distances and labels of dungeonMaze, built with the level */
+    void collectSpawnCells(int firstRow);   /* Open cells from firstRow down, shuffled */
+
+    bool endlessMode;                   /* The dungeon entrance leads to one bottomless maze instead of levels */
+    EndlessMaze* endlessMaze;           /* Streams dungeonMaze while an endless descent is under way */
+    static const int ENDLESS_COLUMNS = 15;
+    static const int ENDLESS_WINDOW_CELL_ROWS = 24;     /* Rows of cells kept at once, whatever the depth */
+    static const int ENDLESS_LOOKAHEAD_CELL_ROWS = 8;   /* Stream more once the player is this close to the bottom */
+    static const int ENDLESS_SCROLL_CELL_ROWS = 8;      /* Dropped and streamed in at a time */
+    static const int ENDLESS_ROWS_PER_DIFFICULTY = 16;  /* Rows of cells descended per difficulty step */
+    static const int ENDLESS_ENEMIES_PER_SCROLL = 3;
+    void startEndless();
+    void streamEndlessRows();
+    void stopEndless();
+    SpriteSheetId enemySheet;           /* One sheet shared by every enemy */
     PathfindingManager pathfindingManager;
 
     int difficulty;
@@ -1,4 +1,4 @@
-#include <GameMap.h>
+#include "GameMap.h"
 
 std::vector<std::vector<int>> mapMatrix = {
     {0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6},
@@ -1,3 +1,6 @@
+#ifndef GAMEMAP_H
+#define GAMEMAP_H
+
 #include <vector>
 
 const int TILE_GRASS = 0;            // Grass tile
@@ -15,6 +18,9 @@ const int TILE_COFFIN = 11;          // Coffin tile
 const int TILE_BONE = 12;
 const int TILE_SKULL = 13;
 const int TILE_HOUSE_GREEN = 14;
+const int TILE_TYPE_COUNT = 15;
 
 // Example map matrix (can be loaded from a file for larger maps)
-extern std::vector<std::vector<int>> mapMatrix;
\ No newline at end of file
+extern std::vector<std::vector<int>> mapMatrix;
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+// Plain geometry for simulation code that must not depend on SDL.
+// Rect follows SDL_Rect's conventions, so the two convert field for field.
+struct Rect {
+    int x, y;
+    int w, h;
+};
+
+struct Vec2 {
+    float x, y;
+};
+
+// Same result as SDL_HasIntersection: empty rects never overlap and
+// touching edges don't count
+inline bool rectsOverlap(const Rect& a, const Rect& b) {
+    if (a.w <= 0 || a.h <= 0 || b.w <= 0 || b.h <= 0) return false;
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+// Same result as SDL_PointInRect
+inline bool rectContains(const Rect& rect, int x, int y) {
+    return x >= rect.x && x < rect.x + rect.w && y >= rect.y && y < rect.y + rect.h;
+}
+
+#endif
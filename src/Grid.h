@@ -0,0 +1,64 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// A width x height block of cells in one contiguous allocation, row after
+// row. grid[y][x] indexes it like the nested vectors it replaces, but a row
+// is a pointer offset rather than a second heap lookup.
+// Move-only: a maze is handed from the generator to the game, never copied.
+template <typename T>
+class Grid {
+public:
+    Grid() : width(0), height(0) {}
+    Grid(int p_width, int p_height, const T& value = T())
+        : width(p_width), height(p_height), cells(static_cast<size_t>(p_width) * p_height, value) {}
+
+    Grid(Grid&& other) noexcept
+        : width(other.width), height(other.height), cells(std::move(other.cells)) {
+        other.width = 0;
+        other.height = 0;
+    }
+    Grid& operator=(Grid&& other) noexcept {
+        width = other.width;
+        height = other.height;
+        cells = std::move(other.cells);
+        other.width = 0;
+        other.height = 0;
+        return *this;
+    }
+
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+
+    // Resizes in place, keeping the allocation when it is already big enough
+    void assign(int p_width, int p_height, const T& value) {
+        width = p_width;
+        height = p_height;
+        cells.assign(static_cast<size_t>(width) * height, value);
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getStride() const { return width; }     // Cells from one row to the next
+    bool empty() const { return cells.empty(); }
+    size_t size() const { return cells.size(); }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    int indexOf(int x, int y) const { return y * width + x; }
+
+    T* operator[](int y) { return cells.data() + static_cast<size_t>(y) * width; }
+    const T* operator[](int y) const { return cells.data() + static_cast<size_t>(y) * width; }
+
+    T* data() { return cells.data(); }
+    const T* data() const { return cells.data(); }
+
+private:
+    int width;
+    int height;
+    std::vector<T> cells;
+};
+
+#endif
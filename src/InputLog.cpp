@@ -0,0 +1,157 @@
+#include "InputLog.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+namespace {
+
+const char LOG_MAGIC[4] = {'G', 'M', 'I', 'L'};
+const uint32_t LOG_VERSION = 1;
+
+static_assert(sizeof(InputRecord) == 16, "InputRecord is written to disk as-is");
+
+struct LogHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t seed;
+    uint32_t endTick;
+    uint32_t recordCount;
+};
+
+}
+
+bool InputLog::isRecordable(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_QUIT:
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void InputLog::record(uint32_t tick, const SDL_Event& event) {
+    InputRecord record{};
+    record.tick = tick;
+
+    switch (event.type) {
+        case SDL_QUIT:
+            record.type = InputRecord::QUIT;
+            break;
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            record.type = event.type == SDL_KEYDOWN ? InputRecord::KEY_DOWN : InputRecord::KEY_UP;
+            record.repeat = event.key.repeat;
+            record.code = static_cast<uint16_t>(event.key.keysym.scancode);
+            record.key = event.key.keysym.sym;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            record.type = event.type == SDL_MOUSEBUTTONDOWN ? InputRecord::MOUSE_DOWN : InputRecord::MOUSE_UP;
+            record.code = event.button.button;
+            record.x = static_cast<int16_t>(event.button.x);
+            record.y = static_cast<int16_t>(event.button.y);
+            break;
+        default:
+            return;
+    }
+
+    records.push_back(record);
+}
+
+SDL_Event InputLog::toEvent(const InputRecord& record) {
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+
+    switch (record.type) {
+        case InputRecord::QUIT:
+            event.type = SDL_QUIT;
+            break;
+        case InputRecord::KEY_DOWN:
+        case InputRecord::KEY_UP:
+            event.type = record.type == InputRecord::KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+            event.key.state = record.type == InputRecord::KEY_DOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.key.repeat = record.repeat;
+            event.key.keysym.scancode = static_cast<SDL_Scancode>(record.code);
+            event.key.keysym.sym = record.key;
+            break;
+        case InputRecord::MOUSE_DOWN:
+        case InputRecord::MOUSE_UP:
+            event.type = record.type == InputRecord::MOUSE_DOWN ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+            event.button.state = record.type == InputRecord::MOUSE_DOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.button.button = static_cast<Uint8>(record.code);
+            event.button.x = record.x;
+            event.button.y = record.y;
+            break;
+    }
+
+    return event;
+}
+
+void InputLog::clear() {
+    records.clear();
+    endTick = 0;
+}
+
+bool InputLog::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open input log " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    LogHeader header;
+    memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+    header.version = LOG_VERSION;
+    header.seed = seed;
+    header.endTick = endTick;
+    header.recordCount = static_cast<uint32_t>(records.size());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(InputRecord));
+    if (!file) {
+        std::cerr << "Failed to write input log " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputLog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open input log " << path << std::endl;
+        return false;
+    }
+
+    LogHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || header.version != LOG_VERSION) {
+        std::cerr << "Input log " << path << " is not a version " << LOG_VERSION << " recording" << std::endl;
+        return false;
+    }
+
+    // Check the count against what is left of the file before allocating,
+    // so a corrupt header can't ask for gigabytes
+    std::streampos recordsStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t remaining = static_cast<uint64_t>(file.tellg() - recordsStart);
+    file.seekg(recordsStart);
+    if (static_cast<uint64_t>(header.recordCount) * sizeof(InputRecord) > remaining) {
+        std::cerr << "Input log " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    records.resize(header.recordCount);
+    if (!file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(InputRecord))) {
+        std::cerr << "Input log " << path << " is truncated" << std::endl;
+        records.clear();
+        return false;
+    }
+
+    seed = header.seed;
+    endTick = header.endTick;
+    return true;
+}
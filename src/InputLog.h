@@ -0,0 +1,51 @@
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One handled input event, stamped with the simulation step it was applied before
+struct InputRecord {
+    enum Type : uint8_t { QUIT, KEY_DOWN, KEY_UP, MOUSE_DOWN, MOUSE_UP };
+
+    uint32_t tick;      // Simulation steps completed when the event was handled
+    uint8_t type;
+    uint8_t repeat;     // Key auto-repeat
+    uint16_t code;      // Scancode, or mouse button
+    int32_t key;        // Keycode
+    int16_t x, y;       // Mouse position, for menu clicks
+};
+
+// Input events the game reacted to, plus the RNG seed, in a compact binary
+// file. Replaying the events at the same simulation steps reproduces a
+// session exactly, which makes recordings usable as a benchmark corpus.
+class InputLog {
+public:
+    InputLog() : seed(0), endTick(0) {}
+
+    static bool isRecordable(const SDL_Event& event);
+    static SDL_Event toEvent(const InputRecord& record);
+
+    void record(uint32_t tick, const SDL_Event& event);
+    void clear();
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    void setSeed(uint64_t value) { seed = value; }
+    uint64_t getSeed() const { return seed; }
+    void setEndTick(uint32_t tick) { endTick = tick; }
+    uint32_t getEndTick() const { return endTick; }   // Steps simulated by the whole recording
+
+    size_t size() const { return records.size(); }
+    const InputRecord& operator[](size_t i) const { return records[i]; }
+
+private:
+    uint64_t seed;
+    uint32_t endTick;
+    std::vector<InputRecord> records;
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "LevelBuilder.h"
+#include "MazeGenerator.h"
+#include "Random.h"
+#include "Profiler.h"
+#include <algorithm>
+
+LevelBuilder::LevelBuilder()
+    : terminate(false), requested(false), ready(false), requestDifficulty(-1), requestSeed(0),
+      prefetchHits(0), prefetchMisses(0) {
+    worker = std::thread(&LevelBuilder::workerThread, this);
+}
+
+LevelBuilder::~LevelBuilder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        terminate = true;
+    }
+    requestCv.notify_one();
+    worker.join();
+}
+
+LevelPlan LevelBuilder::build(int difficulty, uint64_t seed) {
+    PROFILE_ZONE("LevelBuilder::build");
+    LevelPlan level;
+    level.difficulty = difficulty;
+    level.seed = seed;
+
+    // Generators of its own: the shared streams belong to the game thread
+    int mazeWidth = 21 + difficulty;
+    int mazeHeight = 21 + difficulty;
+    Random mazeRng(seed);
+    MazeGenerator generator(mazeWidth, mazeHeight, mazeRng);
+    level.maze = generator.generateMaze();
+
+    // Entrance in the top-left corner, exit to the next level in the bottom-right
+    level.entranceX = 1;
+    level.entranceY = 1;
+    level.exitX = mazeWidth - 2;
+    level.exitY = mazeHeight - 2;
+    level.maze[level.entranceY][level.entranceX] = 2;
+    level.maze[level.exitY][level.exitX] = 3;
+
+    level.metadata.build(level.maze, level.entranceX, level.entranceY, level.exitX, level.exitY);
+
+    // Enemies take the dead ends first, lying in wait off the route, then the
+    // rest of the maze with junctions last so crossings are rarely blocked
+    const LevelMetadata& metadata = level.metadata;
+    int width = level.maze.getWidth();
+    std::vector<std::pair<int, int>> tiers[3];
+    for (int cell : metadata.getWalkableCells()) {
+        int x = cell % width;
+        int y = cell / width;
+        if (level.maze[y][x] != 0 || metadata.getDistanceFromEntrance(x, y) < MIN_SPAWN_DISTANCE) continue;
+
+        CellLabel label = metadata.getLabel(x, y);
+        tiers[label == CellLabel::DeadEnd ? 0 : label == CellLabel::Junction ? 2 : 1].push_back({x, y});
+    }
+    Random spawnRng(~seed);
+    for (auto& tier : tiers) {
+        spawnRng.shuffle(tier.begin(), tier.end());
+        level.spawnCells.insert(level.spawnCells.end(), tier.begin(), tier.end());
+    }
+
+    // A longer way from the entrance to the exit holds more enemies
+    level.enemyCount = difficulty + 1 + std::max(0, metadata.getRouteLength()) / ROUTE_STEPS_PER_ENEMY;
+
+    level.occluders.setWalls(level.maze, TILE_SIZE);
+    return level;
+}
+
+void LevelBuilder::prefetch(int difficulty, uint64_t seed) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requested = true;
+        ready = false;
+        requestDifficulty = difficulty;
+        requestSeed = seed;
+    }
+    requestCv.notify_one();
+}
+
+LevelPlan LevelBuilder::take(int difficulty, uint64_t seed) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (requestDifficulty == difficulty && requestSeed == seed) {
+            readyCv.wait(lock, [this] { return ready; });
+            ready = false;
+            requestDifficulty = -1;     // Taken; a second take builds its own copy
+            prefetchHits++;
+            return std::move(plan);
+        }
+        prefetchMisses++;
+    }
+    return build(difficulty, seed);
+}
+
+void LevelBuilder::workerThread() {
+    Profiler::setThreadName("Level builder");
+
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        requestCv.wait(lock, [this] { return terminate || requested; });
+        if (terminate) break;
+
+        requested = false;
+        int difficulty = requestDifficulty;
+        uint64_t seed = requestSeed;
+        lock.unlock();
+
+        LevelPlan level = build(difficulty, seed);
+
+        lock.lock();
+        // Dropped if a newer request came in while this one was being built
+        if (!requested && requestDifficulty == difficulty && requestSeed == seed) {
+            plan = std::move(level);
+            ready = true;
+            readyCv.notify_all();
+        }
+    }
+}
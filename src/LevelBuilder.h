@@ -0,0 +1,75 @@
+#ifndef LEVELBUILDER_H
+#define LEVELBUILDER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Grid.h"
+#include "LightGeometry.h"
+#include "LevelMetadata.h"
+
+// Everything a dungeon level needs before it can be entered, none of it
+// touching SDL or the live game, so it can be built on any thread
+struct LevelPlan {
+    int difficulty;
+    uint64_t seed;
+    Grid<int> maze;                                 // Entrance (2) and exit (3) already marked
+    int entranceX, entranceY;
+    int exitX, exitY;
+    std::vector<std::pair<int, int>> spawnCells;    // Open cells away from the entrance, in the order enemies take them
+    int enemyCount;                                 // Scaled with the difficulty and the route length
+    LightGeometry occluders;                        // The maze's walls, bucketed for the lighting rays
+    LevelMetadata metadata;                         // Distances, labels and cell lists of the maze
+};
+
+// Builds the next dungeon level on a worker thread while the current one is
+// played, so a level transition only has to swap the finished plan in.
+// A plan depends on nothing but its difficulty and seed: whether it was
+// prefetched or built on demand, the same level comes out.
+class LevelBuilder {
+public:
+    static const int TILE_SIZE = 96;
+    static const int MIN_SPAWN_DISTANCE = 6;    // Steps from the entrance before enemies may spawn
+    static const int ROUTE_STEPS_PER_ENEMY = 40;    // One more enemy per this many steps from entrance to exit
+
+    LevelBuilder();
+    ~LevelBuilder();
+
+    LevelBuilder(const LevelBuilder&) = delete;
+    LevelBuilder& operator=(const LevelBuilder&) = delete;
+
+    static LevelPlan build(int difficulty, uint64_t seed);
+
+    // Starts building a level in the background, replacing any earlier request
+    void prefetch(int difficulty, uint64_t seed);
+
+    // The prefetched plan if it matches (waiting for it if still in progress),
+    // otherwise the level is built on the calling thread
+    LevelPlan take(int difficulty, uint64_t seed);
+
+    unsigned long getPrefetchHits() const { return prefetchHits; }
+    unsigned long getPrefetchMisses() const { return prefetchMisses; }
+
+private:
+    void workerThread();
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable requestCv;
+    std::condition_variable readyCv;
+    bool terminate;
+
+    bool requested;     // A request the worker hasn't picked up yet
+    bool ready;         // `plan` holds the requested level
+    int requestDifficulty;
+    uint64_t requestSeed;
+    LevelPlan plan;
+
+    unsigned long prefetchHits;
+    unsigned long prefetchMisses;
+};
+
+#endif
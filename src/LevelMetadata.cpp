@@ -0,0 +1,86 @@
+#include "LevelMetadata.h"
+#include "Profiler.h"
+#include "TileTypes.h"
+
+namespace {
+    const int DX[4] = { 0, 1, 0, -1 };
+    const int DY[4] = { -1, 0, 1, 0 };
+
+    bool isOpen(const Grid<int>& maze, int x, int y) {
+        return maze.inBounds(x, y) && !dungeonCellDescriptor(maze[y][x]).solid;
+    }
+}
+
+void LevelMetadata::build(const Grid<int>& maze, int p_entranceX, int p_entranceY, int p_exitX, int p_exitY) {
+    PROFILE_ZONE("LevelMetadata::build");
+    entranceX = p_entranceX;
+    entranceY = p_entranceY;
+    exitX = p_exitX;
+    exitY = p_exitY;
+
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    labels.assign(width, height, CellLabel::Wall);
+    walkableCells.clear();
+    deadEnds.clear();
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!isOpen(maze, x, y)) continue;
+            walkableCells.push_back(maze.indexOf(x, y));
+
+            int openSides = 0;
+            for (int dir = 0; dir < 4; ++dir) {
+                if (isOpen(maze, x + DX[dir], y + DY[dir])) ++openSides;
+            }
+
+            // Any of the four 2x2 blocks this cell is a corner of, fully open
+            bool room = false;
+            for (int oy = -1; oy <= 0 && !room; ++oy) {
+                for (int ox = -1; ox <= 0 && !room; ++ox) {
+                    room = isOpen(maze, x + ox, y + oy) && isOpen(maze, x + ox + 1, y + oy) &&
+                           isOpen(maze, x + ox, y + oy + 1) && isOpen(maze, x + ox + 1, y + oy + 1);
+                }
+            }
+
+            if (room) {
+                labels[y][x] = CellLabel::Room;
+            } else if (openSides <= 1) {
+                labels[y][x] = CellLabel::DeadEnd;
+                deadEnds.push_back(maze.indexOf(x, y));
+            } else if (openSides == 2) {
+                labels[y][x] = CellLabel::Corridor;
+            } else {
+                labels[y][x] = CellLabel::Junction;
+            }
+        }
+    }
+
+    std::vector<int> queue;
+    queue.reserve(walkableCells.size());
+    distancesFrom(maze, entranceX, entranceY, fromEntrance, queue);
+    distancesFrom(maze, exitX, exitY, toExit, queue);
+}
+
+void LevelMetadata::distancesFrom(const Grid<int>& maze, int x, int y, Grid<int>& distance, std::vector<int>& queue) {
+    distance.assign(maze.getWidth(), maze.getHeight(), -1);
+    if (!isOpen(maze, x, y)) return;
+
+    // Breadth-first, with the queue as a plain vector read from the front
+    queue.clear();
+    distance[y][x] = 0;
+    queue.push_back(maze.indexOf(x, y));
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cx = queue[head] % maze.getWidth();
+        int cy = queue[head] / maze.getWidth();
+        int next = distance[cy][cx] + 1;
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = cx + DX[dir];
+            int ny = cy + DY[dir];
+            if (isOpen(maze, nx, ny) && distance[ny][nx] == -1) {
+                distance[ny][nx] = next;
+                queue.push_back(maze.indexOf(nx, ny));
+            }
+        }
+    }
+}
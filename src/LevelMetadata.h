@@ -0,0 +1,52 @@
+#ifndef LEVELMETADATA_H
+#define LEVELMETADATA_H
+
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+
+// What a cell of the maze is, by the shape of the open space around it
+enum class CellLabel : uint8_t {
+    Wall,
+    Corridor,       // Open on two sides
+    Junction,       // Open on three or four sides
+    DeadEnd,        // Open on one side (or none)
+    Room            // Part of an open 2x2 block or wider
+};
+
+// Structure of one level, derived from its maze once when the level is built
+// so nothing during play has to rescan the maze for it. Distances count steps
+// between orthogonally adjacent open cells; -1 means unreachable or a wall.
+class LevelMetadata {
+public:
+    LevelMetadata() : entranceX(0), entranceY(0), exitX(0), exitY(0) {}
+
+    void build(const Grid<int>& maze, int entranceX, int entranceY, int exitX, int exitY);
+    bool empty() const { return labels.empty(); }
+
+    int getDistanceFromEntrance(int x, int y) const { return inBounds(x, y) ? fromEntrance[y][x] : -1; }
+    int getDistanceToExit(int x, int y) const { return inBounds(x, y) ? toExit[y][x] : -1; }
+    CellLabel getLabel(int x, int y) const { return inBounds(x, y) ? labels[y][x] : CellLabel::Wall; }
+    bool isExit(int x, int y) const { return !empty() && x == exitX && y == exitY; }
+
+    int getRouteLength() const { return getDistanceToExit(entranceX, entranceY); }  // Entrance to exit
+
+    // Cell indices (y * width + x) in row order
+    const std::vector<int>& getWalkableCells() const { return walkableCells; }
+    const std::vector<int>& getDeadEnds() const { return deadEnds; }
+    int getWidth() const { return labels.getWidth(); }
+
+private:
+    bool inBounds(int x, int y) const { return labels.inBounds(x, y); }
+    static void distancesFrom(const Grid<int>& maze, int x, int y, Grid<int>& distance, std::vector<int>& queue);
+
+    int entranceX, entranceY;
+    int exitX, exitY;
+    Grid<int> fromEntrance;
+    Grid<int> toExit;
+    Grid<CellLabel> labels;
+    std::vector<int> walkableCells;
+    std::vector<int> deadEnds;
+};
+
+#endif
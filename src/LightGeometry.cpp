@@ -0,0 +1,215 @@
+#include "LightGeometry.h"
+#include "TileTypes.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+
+const int GRID_CELL_SIZE = 192; // Adjust grid cell size as needed
+const float EPSILON = 1e-6f;
+
+LightGeometry::LightGeometry() : gridWidth(0), gridHeight(0), obstacleCount(0) {}
+
+void LightGeometry::setWalls(const Grid<int>& maze, int tileSize) {
+    obstacles.clear();
+    if (maze.empty()) {
+        setObstacles(obstacles, 0, 0);
+        return;
+    }
+
+    for (int y = 0; y < maze.getHeight(); ++y) {
+        for (int x = 0; x < maze.getWidth(); ++x) {
+            if (dungeonCellDescriptor(maze[y][x]).occludesLight) {
+                obstacles.push_back({x * tileSize, y * tileSize, tileSize, tileSize});
+            }
+        }
+    }
+
+    setObstacles(obstacles, maze.getWidth() * tileSize, maze.getHeight() * tileSize);
+}
+
+void LightGeometry::setObstacles(const std::vector<Rect>& newObstacles, int worldWidth, int worldHeight) {
+    // Resized whenever the world changes size, so walls of a bigger maze aren't dropped
+    int width = (worldWidth + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
+    int height = (worldHeight + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
+    if (width != gridWidth || height != gridHeight) {
+        gridWidth = width;
+        gridHeight = height;
+        grid.assign(gridWidth * gridHeight, {});
+    }
+
+    for (auto& cell : grid) {
+        cell.clear();
+    }
+
+    for (const auto& obstacle : newObstacles) {
+        int minX = obstacle.x / GRID_CELL_SIZE;
+        int minY = obstacle.y / GRID_CELL_SIZE;
+        int maxX = (obstacle.x + obstacle.w) / GRID_CELL_SIZE;
+        int maxY = (obstacle.y + obstacle.h) / GRID_CELL_SIZE;
+
+        for (int x = minX; x <= maxX; ++x) {
+            for (int y = minY; y <= maxY; ++y) {
+                if (x >= 0 && x < gridWidth && y >= 0 && y < gridHeight) {
+                    grid[y * gridWidth + x].push_back(obstacle);
+                }
+            }
+        }
+    }
+    obstacleCount = newObstacles.size();
+}
+
+std::vector<Rect> LightGeometry::getPotentialObstacles(const Vec2& start, const Vec2& end) const {
+    std::vector<Rect> potentialObstacles;
+    if (grid.empty()) return potentialObstacles;
+
+    // Determine which grid cells the ray passes through
+    int x0 = static_cast<int>(start.x) / GRID_CELL_SIZE;
+    int y0 = static_cast<int>(start.y) / GRID_CELL_SIZE;
+    int x1 = static_cast<int>(end.x) / GRID_CELL_SIZE;
+    int y1 = static_cast<int>(end.y) / GRID_CELL_SIZE;
+
+    x0 = std::max(0, std::min(x0, gridWidth - 1));
+    y0 = std::max(0, std::min(y0, gridHeight - 1));
+    x1 = std::max(0, std::min(x1, gridWidth - 1));
+    y1 = std::max(0, std::min(y1, gridHeight - 1));
+
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+
+    int n = 1 + dx + dy;
+    int x_inc = (x1 > x0) ? 1 : -1;
+    int y_inc = (y1 > y0) ? 1 : -1;
+    int error = dx - dy;
+
+    dx *= 2;
+    dy *= 2;
+
+    int x = x0;
+    int y = y0;
+
+    for (; n > 0; --n) {
+        const auto& cellObstacles = grid[y * gridWidth + x];
+        potentialObstacles.insert(potentialObstacles.end(),
+                                  cellObstacles.begin(), cellObstacles.end());
+
+        if (error > 0) {
+            x += x_inc;
+            error -= dy;
+        } else {
+            y += y_inc;
+            error += dx;
+        }
+    }
+
+    return potentialObstacles;
+}
+
+std::vector<LightRay> LightGeometry::castRays(Vec2 lightPos, float radius, int numRays) const {
+    std::vector<LightRay> rays;
+
+    for (int i = 0; i < numRays; ++i) {
+        double angle = (2.0 * M_PI) * i / numRays + 0.0001;
+        double dirX = cos(angle);
+        double dirY = sin(angle);
+
+        Vec2 dir = { static_cast<float>(dirX), static_cast<float>(dirY) };
+        Vec2 endPoint = { lightPos.x + dir.x * radius,
+                          lightPos.y + dir.y * radius };
+
+        // Get potential obstacles using spatial partitioning
+        std::vector<Rect> potentialObstacles = getPotentialObstacles(lightPos, endPoint);
+
+        // **Filter out obstacles that contain the light source**
+        potentialObstacles.erase(
+            std::remove_if(potentialObstacles.begin(), potentialObstacles.end(),
+                [lightPos](const Rect& rect) {
+                    return rectContains(rect, static_cast<int>(lightPos.x), static_cast<int>(lightPos.y));
+                }),
+            potentialObstacles.end());
+
+        // Perform ray-wall intersection to find the closest obstacle
+        float closestDist = radius;
+        Vec2 closestPoint = endPoint;
+
+        for (const auto& obstacle : potentialObstacles) {
+            Vec2 intersectionPoint;
+            if (rayIntersectsRect(lightPos, endPoint, obstacle, intersectionPoint)) {
+                float dist = hypotf(intersectionPoint.x - lightPos.x,
+                                    intersectionPoint.y - lightPos.y);
+                if (dist < closestDist) {
+                    closestDist = dist;
+                    closestPoint = intersectionPoint;
+                }
+            }
+        }
+
+        rays.push_back({ lightPos, closestPoint });
+    }
+
+    return rays;
+}
+
+bool LightGeometry::rayIntersectsRect(Vec2 rayStart, Vec2 rayEnd, const Rect& rect, Vec2& outIntersection) {
+    // Define the rectangle edges as lines
+    const Vec2 rectEdges[4][2] = {
+        { { (float)rect.x, (float)rect.y },
+          { (float)(rect.x + rect.w), (float)rect.y } }, // Top edge
+        { { (float)(rect.x + rect.w), (float)rect.y },
+          { (float)(rect.x + rect.w), (float)(rect.y + rect.h) } }, // Right edge
+        { { (float)(rect.x + rect.w), (float)(rect.y + rect.h) },
+          { (float)rect.x, (float)(rect.y + rect.h) } }, // Bottom edge
+        { { (float)rect.x, (float)(rect.y + rect.h) },
+          { (float)rect.x, (float)rect.y } } // Left edge
+    };
+
+    bool hit = false;
+    float closestDist = std::numeric_limits<float>::max();
+
+    for (const auto& edge : rectEdges) {
+        Vec2 intersectionPoint;
+        if (lineLineIntersection(rayStart, rayEnd, edge[0], edge[1], intersectionPoint)) {
+            float dist = hypotf(intersectionPoint.x - rayStart.x,
+                                intersectionPoint.y - rayStart.y);
+            if (dist < closestDist) {
+                closestDist = dist;
+                outIntersection = intersectionPoint;
+                hit = true;
+            }
+        }
+    }
+
+    return hit;
+}
+
+bool LightGeometry::lineLineIntersection(Vec2 p1, Vec2 p2, Vec2 p3, Vec2 p4, Vec2& outIntersection) {
+    // Line AB represented as p1 + r * (p2 - p1)
+    // Line CD represented as p3 + s * (p4 - p3)
+    Vec2 r = { p2.x - p1.x, p2.y - p1.y };
+    Vec2 s = { p4.x - p3.x, p4.y - p3.y };
+
+    float rxs = r.x * s.y - r.y * s.x;
+    float qpxr = (p3.x - p1.x) * r.y - (p3.y - p1.y) * r.x;
+
+    if (fabsf(rxs) < EPSILON && fabsf(qpxr) < EPSILON) {
+        // Lines are colinear
+        return false;
+    }
+
+    if (fabsf(rxs) < EPSILON && fabsf(qpxr) >= EPSILON) {
+        // Lines are parallel and non-intersecting
+        return false;
+    }
+
+    float t = ((p3.x - p1.x) * s.y - (p3.y - p1.y) * s.x) / rxs;
+    float u = ((p3.x - p1.x) * r.y - (p3.y - p1.y) * r.x) / rxs;
+
+    if (t >= -EPSILON && t <= 1 + EPSILON && u >= -EPSILON && u <= 1 + EPSILON) {
+        // Intersection point
+        outIntersection.x = p1.x + t * r.x;
+        outIntersection.y = p1.y + t * r.y;
+        return true;
+    }
+
+    return false;
+}
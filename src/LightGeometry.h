@@ -0,0 +1,42 @@
+#ifndef LIGHTGEOMETRY_H
+#define LIGHTGEOMETRY_H
+
+#include <cstddef>
+#include <vector>
+#include "Geometry.h"
+#include "Grid.h"
+
+struct LightRay {
+    Vec2 start;
+    Vec2 end;   // Where the ray stops: the first wall it meets, or its full radius
+};
+
+// The ray-casting half of the lighting: wall rectangles bucketed into a
+// coarse spatial grid, and rays fanned out from a light against them.
+// Nothing here touches SDL; LightingManager turns the rays into triangles.
+class LightGeometry {
+public:
+    LightGeometry();
+
+    // Rebuilds the obstacle grid from every light-occluding cell of a dungeon maze
+    void setWalls(const Grid<int>& maze, int tileSize);
+    void setObstacles(const std::vector<Rect>& obstacles, int worldWidth, int worldHeight);
+
+    std::vector<LightRay> castRays(Vec2 lightPos, float radius, int numRays) const;
+
+    size_t getObstacleCount() const { return obstacleCount; }
+
+private:
+    std::vector<Rect> getPotentialObstacles(const Vec2& start, const Vec2& end) const;
+    static bool rayIntersectsRect(Vec2 rayStart, Vec2 rayEnd, const Rect& rect, Vec2& outIntersection);
+    static bool lineLineIntersection(Vec2 p1, Vec2 p2, Vec2 p3, Vec2 p4, Vec2& outIntersection);
+
+    // Spatial partitioning grid
+    int gridWidth;
+    int gridHeight;
+    std::vector<std::vector<Rect>> grid;
+    std::vector<Rect> obstacles;        // Reused between rebuilds
+    size_t obstacleCount;
+};
+
+#endif
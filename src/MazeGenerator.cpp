@@ -1,19 +1,67 @@
 #include "MazeGenerator.h"
-#include <random>
+#include "EllerMaze.h"
+#include "TiledMazeGenerator.h"
 
-MazeGenerator::MazeGenerator(int width, int height) : width(width), height(height) {
-    std::srand(std::time(0)); // Seed for random number generation
+namespace {
+    // Cell steps in the order up, right, down, left
+    const int CELL_DX[4] = { 0, 1, 0, -1 };
+    const int CELL_DY[4] = { -1, 0, 1, 0 };
+
+    // Binary space partition of the cell grid for the rooms-and-corridors layout
+    const int BSP_MAX_LEAF = 12;    // Leaves wider or taller than this many cells get split
+    const int BSP_MIN_LEAF = 4;
+
+    struct BspNode {
+        int x, y, w, h;     // In cells
+        int left, right;    // Child nodes, -1 for a leaf
+        int repX, repY;     // A cell inside one of the node's rooms, corridors run between these
+    };
+}
+
+const char* mazeAlgorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+        case MazeAlgorithm::Backtracker:        return "backtracker";
+        case MazeAlgorithm::Wilson:             return "wilson";
+        case MazeAlgorithm::Eller:              return "eller";
+        case MazeAlgorithm::RecursiveDivision:  return "recursive-division";
+        case MazeAlgorithm::RoomsAndCorridors:  return "rooms-and-corridors";
+        case MazeAlgorithm::Tiled:              return "tiled";
+        default:                                return "unknown";
+    }
 }
 
-std::vector<std::vector<int>> MazeGenerator::generateMaze() {
-    initializeMaze();
-    carveMaze(1, 1);
-    refineMaze();
-    return maze;
+MazeGenerator::MazeGenerator(int width, int height, Random& rng, MazeAlgorithm algorithm)
+    : width(width), height(height), rng(rng), algorithm(algorithm) {}
+
+Grid<int> MazeGenerator::generateMaze() {
+    if (algorithm == MazeAlgorithm::Backtracker) {
+        initializeMaze();
+        carveMaze(1, 1);
+        refineMaze();
+        return std::move(maze);
+    }
+    if (algorithm == MazeAlgorithm::Tiled) {
+        uint64_t seed = rng.next();
+        seed = (seed << 32) | rng.next();
+        TiledMazeGenerator tiled(width, height, seed);
+        return tiled.generateMaze();
+    }
+
+    maze.assign(width, height, -1);
+    if (width >= 3 && height >= 3) {
+        switch (algorithm) {
+            case MazeAlgorithm::Wilson:             generateWilson(); break;
+            case MazeAlgorithm::Eller:              generateEller(); break;
+            case MazeAlgorithm::RecursiveDivision:  generateRecursiveDivision(); break;
+            case MazeAlgorithm::RoomsAndCorridors:  generateRoomsAndCorridors(); break;
+            default: break;
+        }
+    }
+    return std::move(maze);
 }
 
 void MazeGenerator::initializeMaze() {
-    maze = std::vector<std::vector<int>>(height, std::vector<int>(width, -1));
+    maze.assign(width, height, -1);
     for (int y = 0; y < height; y += 2) {
         for (int x = 0; x < width; x += 2) {
             maze[y][x] = 0;
@@ -34,8 +82,8 @@ void MazeGenerator::carveMaze(int x, int y) {
         std::tie(cx, cy) = stack.top();
         stack.pop();
 
-        std::vector<int> dir_indices = { 0, 1, 2, 3 };
-        std::shuffle(dir_indices.begin(), dir_indices.end(), std::default_random_engine(std::rand()));
+        int dir_indices[4] = { 0, 1, 2, 3 };
+        rng.shuffle(dir_indices, dir_indices + 4);
 
         for (int i : dir_indices) {
             int nx = cx + directions[i][0];
@@ -50,19 +98,11 @@ void MazeGenerator::carveMaze(int x, int y) {
 }
 
 void MazeGenerator::refineMaze() {
-    std::vector<std::vector<int>> newMaze = maze;
     int directions[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
 
-    // Ensure the margins of the maze are all -1
-    for (int x = 0; x < width; ++x) {
-        newMaze[0][x] = -1;
-        newMaze[height - 1][x] = -1;
-    }
-    for (int y = 0; y < height; ++y) {
-        newMaze[y][0] = -1;
-        newMaze[y][width - 1] = -1;
-    }
-
+    // Find every dead end against the unrefined maze first, then wall them
+    // off, so the maze is refined in place instead of through a copy
+    deadEnds.clear();
     for (int y = 1; y < height - 1; ++y) {
         for (int x = 1; x < width - 1; ++x) {
             if (maze[y][x] == 0) {
@@ -75,14 +115,183 @@ void MazeGenerator::refineMaze() {
                     }
                 }
                 if (wallCount >= 3) {
-                    newMaze[y][x] = -1;
+                    deadEnds.push_back(maze.indexOf(x, y));
                 }
             }
         }
     }
-    maze = newMaze;
+
+    // Ensure the margins of the maze are all -1
+    for (int x = 0; x < width; ++x) {
+        maze[0][x] = -1;
+        maze[height - 1][x] = -1;
+    }
+    for (int y = 0; y < height; ++y) {
+        maze[y][0] = -1;
+        maze[y][width - 1] = -1;
+    }
+
+    for (int cell : deadEnds) {
+        maze.data()[cell] = -1;
+    }
 }
 
 bool MazeGenerator::isInBounds(int x, int y) {
     return x > 0 && x < width - 1 && y > 0 && y < height - 1;
 }
+
+void MazeGenerator::generateWilson() {
+    int cols = (width - 1) / 2;
+    int rows = (height - 1) / 2;
+
+    // A cell is in the tree once its grid square is open; `scratch` holds the
+    // direction each walk last left a cell by, which erases loops for free
+    scratch.assign(cols * rows, 0);
+    int root = static_cast<int>(rng.nextBelow(cols * rows));
+    maze[2 * (root / cols) + 1][2 * (root % cols) + 1] = 0;
+
+    for (int start = 0; start < cols * rows; ++start) {
+        int cx = start % cols;
+        int cy = start / cols;
+        while (maze[2 * cy + 1][2 * cx + 1] != 0) {
+            int dir;
+            int nx, ny;
+            do {
+                dir = static_cast<int>(rng.nextBelow(4));
+                nx = cx + CELL_DX[dir];
+                ny = cy + CELL_DY[dir];
+            } while (nx < 0 || nx >= cols || ny < 0 || ny >= rows);
+            scratch[cy * cols + cx] = dir;
+            cx = nx;
+            cy = ny;
+        }
+
+        // Retrace the loop-erased walk, adding it to the tree
+        cx = start % cols;
+        cy = start / cols;
+        while (maze[2 * cy + 1][2 * cx + 1] != 0) {
+            int dir = scratch[cy * cols + cx];
+            maze[2 * cy + 1][2 * cx + 1] = 0;
+            maze[2 * cy + 1 + CELL_DY[dir]][2 * cx + 1 + CELL_DX[dir]] = 0;
+            cx += CELL_DX[dir];
+            cy += CELL_DY[dir];
+        }
+    }
+}
+
+void MazeGenerator::generateEller() {
+    int rows = (height - 1) / 2;
+    EllerMaze eller((width - 1) / 2, rng);
+    for (int r = 0; r < rows; ++r) {
+        eller.nextRow(maze[2 * r + 1], maze[2 * r + 2], r == rows - 1);
+    }
+}
+
+void MazeGenerator::generateRecursiveDivision() {
+    int cols = (width - 1) / 2;
+    int rows = (height - 1) / 2;
+    carveRect(1, 1, 2 * cols - 1, 2 * rows - 1);
+
+    // Chambers in cells; an explicit stack so a 4k map can't overflow the call stack
+    struct Chamber { int x, y, w, h; };
+    std::vector<Chamber> chambers;
+    chambers.push_back({ 0, 0, cols, rows });
+
+    while (!chambers.empty()) {
+        Chamber c = chambers.back();
+        chambers.pop_back();
+        if (c.w < 2 || c.h < 2) continue;
+
+        bool horizontal = c.h > c.w || (c.h == c.w && (rng.next() & 1));
+        if (horizontal) {
+            int split = static_cast<int>(rng.nextBelow(c.h - 1));     // Wall below this row of cells
+            int gap = c.x + static_cast<int>(rng.nextBelow(c.w));
+            int wy = 2 * (c.y + split) + 2;
+            for (int x = 2 * c.x + 1; x < 2 * (c.x + c.w); ++x) {
+                maze[wy][x] = -1;
+            }
+            maze[wy][2 * gap + 1] = 0;
+            chambers.push_back({ c.x, c.y, c.w, split + 1 });
+            chambers.push_back({ c.x, c.y + split + 1, c.w, c.h - split - 1 });
+        } else {
+            int split = static_cast<int>(rng.nextBelow(c.w - 1));
+            int gap = c.y + static_cast<int>(rng.nextBelow(c.h));
+            int wx = 2 * (c.x + split) + 2;
+            for (int y = 2 * c.y + 1; y < 2 * (c.y + c.h); ++y) {
+                maze[y][wx] = -1;
+            }
+            maze[2 * gap + 1][wx] = 0;
+            chambers.push_back({ c.x, c.y, split + 1, c.h });
+            chambers.push_back({ c.x + split + 1, c.y, c.w - split - 1, c.h });
+        }
+    }
+}
+
+void MazeGenerator::generateRoomsAndCorridors() {
+    int cols = (width - 1) / 2;
+    int rows = (height - 1) / 2;
+
+    // Children always come after their parent, so walking the nodes backwards
+    // visits every subtree before the node that joins it
+    std::vector<BspNode> nodes;
+    nodes.push_back({ 0, 0, cols, rows, -1, -1, 0, 0 });
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        BspNode node = nodes[i];
+        bool splitX = node.w > BSP_MAX_LEAF && node.w >= 2 * BSP_MIN_LEAF;
+        bool splitY = node.h > BSP_MAX_LEAF && node.h >= 2 * BSP_MIN_LEAF;
+        if (!splitX && !splitY) continue;
+        if (splitX && splitY) {
+            splitX = node.w > node.h || (node.w == node.h && (rng.next() & 1));
+        }
+
+        int span = splitX ? node.w : node.h;
+        int cut = BSP_MIN_LEAF + static_cast<int>(rng.nextBelow(span - 2 * BSP_MIN_LEAF + 1));
+        int left = static_cast<int>(nodes.size());
+        if (splitX) {
+            nodes.push_back({ node.x, node.y, cut, node.h, -1, -1, 0, 0 });
+            nodes.push_back({ node.x + cut, node.y, node.w - cut, node.h, -1, -1, 0, 0 });
+        } else {
+            nodes.push_back({ node.x, node.y, node.w, cut, -1, -1, 0, 0 });
+            nodes.push_back({ node.x, node.y + cut, node.w, node.h - cut, -1, -1, 0, 0 });
+        }
+        nodes[i].left = left;
+        nodes[i].right = left + 1;
+    }
+
+    for (int i = static_cast<int>(nodes.size()) - 1; i >= 0; --i) {
+        BspNode& node = nodes[i];
+        if (node.left < 0) {
+            // A room covering at least half of the leaf each way
+            int roomW = (node.w + 1) / 2 + static_cast<int>(rng.nextBelow(node.w / 2 + 1));
+            int roomH = (node.h + 1) / 2 + static_cast<int>(rng.nextBelow(node.h / 2 + 1));
+            int roomX = node.x + static_cast<int>(rng.nextBelow(node.w - roomW + 1));
+            int roomY = node.y + static_cast<int>(rng.nextBelow(node.h - roomH + 1));
+            carveRect(2 * roomX + 1, 2 * roomY + 1, 2 * (roomX + roomW) - 1, 2 * (roomY + roomH) - 1);
+            node.repX = 2 * (roomX + roomW / 2) + 1;
+            node.repY = 2 * (roomY + roomH / 2) + 1;
+            continue;
+        }
+
+        // Join the two halves: along the row of one room's centre, then down
+        // the column of the other's
+        const BspNode& a = nodes[node.left];
+        const BspNode& b = nodes[node.right];
+        carveRect(std::min(a.repX, b.repX), a.repY, std::max(a.repX, b.repX), a.repY);
+        carveRect(b.repX, std::min(a.repY, b.repY), b.repX, std::max(a.repY, b.repY));
+        if (rng.next() & 1) {
+            node.repX = a.repX;
+            node.repY = a.repY;
+        } else {
+            node.repX = b.repX;
+            node.repY = b.repY;
+        }
+    }
+}
+
+void MazeGenerator::carveRect(int x0, int y0, int x1, int y1) {
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            maze[y][x] = 0;
+        }
+    }
+}
@@ -8,20 +8,47 @@
 #include <ctime>
 #include <algorithm>
 #include <tuple>
+#include "Random.h"
+#include "Grid.h"
+
+// Every algorithm fills the same -1 wall / 0 path grid with a solid border.
+// The new ones keep cells on odd coordinates, so an even width or height just
+// leaves an extra wall line on the right or bottom.
+enum class MazeAlgorithm {
+    Backtracker,            // Randomized depth-first carve, then dead ends trimmed
+    Wilson,                 // Loop-erased random walks: uniform spanning tree
+    Eller,                  // Row by row in O(width) state, see EllerMaze
+    RecursiveDivision,      // Open floor split by walls with one gap each
+    RoomsAndCorridors,      // BSP rooms joined by L-shaped corridors
+    Tiled,                  // Backtracker per tile on every core, see TiledMazeGenerator
+    Count
+};
+
+const char* mazeAlgorithmName(MazeAlgorithm algorithm);
 
 class MazeGenerator {
 public:
-    MazeGenerator(int width, int height);
-    std::vector<std::vector<int>> generateMaze();
+    MazeGenerator(int width, int height, Random& rng, MazeAlgorithm algorithm = MazeAlgorithm::Backtracker);
+    Grid<int> generateMaze();   // -1 walls, 0 paths; moved out, so the generator keeps no copy
 
 private:
     int width;
     int height;
-    std::vector<std::vector<int>> maze;
+    Random& rng;
+    MazeAlgorithm algorithm;
+    Grid<int> maze;
+    std::vector<int> deadEnds;  // Cell indices refineMaze walls off, reused between mazes
+    std::vector<int> scratch;   // Per-cell walk directions for Wilson's, reused between mazes
     void initializeMaze();
     void carveMaze(int x, int y);
     bool isInBounds(int x, int y);
     void refineMaze();
+
+    void generateWilson();
+    void generateEller();
+    void generateRecursiveDivision();
+    void generateRoomsAndCorridors();
+    void carveRect(int x0, int y0, int x1, int y1);
 };
 
 #endif // MAZEGENERATOR_H
@@ -0,0 +1,138 @@
+#include "Pathfinding.h"
+#include "Profiler.h"
+#include "TileTypes.h"
+#include <queue>
+#include <cstdlib>
+#include <climits>
+#include <functional>
+#include <algorithm>
+
+std::vector<std::pair<int, int>> findPath(const Grid<int>& maze,
+                                          int startX, int startY, int goalX, int goalY) {
+    std::vector<std::pair<int, int>> path;
+    if (maze.empty() || (startX == goalX && startY == goalY)) return path;
+
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    if (startX < 0 || startX >= width || startY < 0 || startY >= height) return path;
+    if (goalX < 0 || goalX >= width || goalY < 0 || goalY >= height) return path;
+
+    // Cost and parent per cell instead of a path copy per queued node;
+    // the path is rebuilt once from the parents when the goal is reached
+    std::vector<int> costSoFar(width * height, INT_MAX);
+    std::vector<int> cameFrom(width * height, -1);
+
+    // (estimated total, cell index), cheapest first
+    using Node = std::pair<int, int>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
+
+    int start = startY * width + startX;
+    int goal = goalY * width + goalX;
+    costSoFar[start] = 0;
+    openSet.emplace(std::abs(startX - goalX) + std::abs(startY - goalY), start);
+
+    static const int directions[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+    while (!openSet.empty()) {
+        auto [priority, current] = openSet.top();
+        openSet.pop();
+
+        int x = current % width;
+        int y = current / width;
+        int cost = costSoFar[current];
+        if (priority > cost + std::abs(x - goalX) + std::abs(y - goalY)) continue;  // Superseded entry
+        PROFILE_COUNT(COUNTER_ASTAR_EXPANSIONS, 1);
+
+        if (current == goal) {
+            for (int cell = goal; cell != start; cell = cameFrom[cell]) {
+                path.emplace_back(cell % width, cell / width);
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        for (const auto& direction : directions) {
+            int nextX = x + direction[0];
+            int nextY = y + direction[1];
+            if (!maze.inBounds(nextX, nextY) || dungeonCellDescriptor(maze[nextY][nextX]).solid) continue;
+
+            int next = nextY * width + nextX;
+            int newCost = cost + 1;
+            if (newCost < costSoFar[next]) {
+                costSoFar[next] = newCost;
+                cameFrom[next] = current;
+                openSet.emplace(newCost + std::abs(nextX - goalX) + std::abs(nextY - goalY), next);
+            }
+        }
+    }
+
+    return path;
+}
+
+void distancesToGoal(const Grid<int>& maze, int goalX, int goalY, Grid<int>& distances) {
+    PROFILE_ZONE("distancesToGoal");
+    int width = maze.getWidth();
+    distances.assign(width, maze.getHeight(), -1);
+    if (!maze.inBounds(goalX, goalY) || dungeonCellDescriptor(maze[goalY][goalX]).solid) return;
+
+    // Every step costs the same, so a FIFO frontier settles cells in distance order
+    std::vector<int> frontier;
+    frontier.reserve(maze.size());
+    int goal = maze.indexOf(goalX, goalY);
+    distances.data()[goal] = 0;
+    frontier.push_back(goal);
+
+    static const int directions[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+    for (size_t head = 0; head < frontier.size(); ++head) {
+        int current = frontier[head];
+        int x = current % width;
+        int y = current / width;
+        int distance = distances.data()[current] + 1;
+
+        for (const auto& direction : directions) {
+            int nextX = x + direction[0];
+            int nextY = y + direction[1];
+            if (!maze.inBounds(nextX, nextY) || dungeonCellDescriptor(maze[nextY][nextX]).solid) continue;
+
+            int next = maze.indexOf(nextX, nextY);
+            if (distances.data()[next] >= 0) continue;
+            distances.data()[next] = distance;
+            frontier.push_back(next);
+        }
+    }
+}
+
+std::vector<std::pair<int, int>> pathDownDistances(const Grid<int>& distances, int startX, int startY) {
+    std::vector<std::pair<int, int>> path;
+    if (!distances.inBounds(startX, startY) || distances[startY][startX] == 0) return path;
+
+    // Each step goes to the open neighbour nearest the goal. From an open cell
+    // that is one step closer; a start inside a wall steps out like findPath does.
+    static const int directions[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+    int x = startX;
+    int y = startY;
+    int distance = distances[y][x];
+    do {
+        int bestX = -1, bestY = -1, best = INT_MAX;
+        for (const auto& direction : directions) {
+            int nextX = x + direction[0];
+            int nextY = y + direction[1];
+            if (!distances.inBounds(nextX, nextY)) continue;
+            int next = distances[nextY][nextX];
+            if (next >= 0 && next < best) {
+                best = next;
+                bestX = nextX;
+                bestY = nextY;
+            }
+        }
+        if (bestX < 0 || (distance >= 0 && best >= distance)) {
+            path.clear();   // Unreachable
+            return path;
+        }
+        x = bestX;
+        y = bestY;
+        distance = best;
+        path.emplace_back(x, y);
+    } while (distance > 0);
+
+    return path;
+}
@@ -0,0 +1,23 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include <vector>
+#include <utility>
+#include "Grid.h"
+
+// Shortest 4-connected path through a dungeon maze, where -1 marks a wall.
+// Returns the cells after the start up to and including the goal; empty if
+// the goal is unreachable or is the start itself.
+std::vector<std::pair<int, int>> findPath(const Grid<int>& maze,
+                                          int startX, int startY, int goalX, int goalY);
+
+// Steps from every cell to (goalX, goalY), -1 where the goal can't be reached.
+// One breadth-first pass, after which a path from any start is a walk down
+// the distances instead of a search of its own.
+void distancesToGoal(const Grid<int>& maze, int goalX, int goalY, Grid<int>& distances);
+
+// A shortest path from (startX, startY) read off distancesToGoal, in
+// findPath's format
+std::vector<std::pair<int, int>> pathDownDistances(const Grid<int>& distances, int startX, int startY);
+
+#endif
@@ -1,76 +1,56 @@
 #include "PathfindingManager.h"
 #include "Player.h"  // Include full definition of Player
-#include "Game.h"    // Include full definition of Game
+#include "SimulationContext.h"
 #include "Enemy.h"   // Include full definition of Enemy
-#include <queue>
+#include "Profiler.h"
+#include "Pathfinding.h"
 #include <cmath>
 
 const int CELL_SIZE = 96;
 const int ENEMY_PADDING_X = 32;
 const int ENEMY_PADDING_Y = 56;
 
-std::vector<std::pair<int, int>> PathfindingManager::getSharedPathToPlayer(Player& player, Game& game, Enemy& enemy) {
+SharedPath PathfindingManager::getSharedPathToPlayer(Player& player, SimulationContext& context, Enemy& enemy) {
     int gridKey = calculateGridKey(static_cast<int>(enemy.getX()), static_cast<int>(enemy.getY()));
 
-    if (sharedPaths.find(gridKey) == sharedPaths.end()) {
-        sharedPaths[gridKey] = calculateSharedPath(player, game, gridKey);
+    lookups++;
+    auto cached = sharedPaths.find(gridKey);
+    if (cached != sharedPaths.end()) {
+        cacheHits++;
+        return cached->second;
     }
 
-    return sharedPaths[gridKey];
+    SharedPath path = calculateSharedPath(player, context, gridKey);
+    sharedPaths.emplace(gridKey, path);
+    return path;
 }
 
-std::vector<std::pair<int, int>> PathfindingManager::calculateSharedPath(Player& player, Game& game, int gridKey) {
-    auto& dungeonMaze = game.getDungeonMaze();
-    int startX = gridKey % 100;
-    int startY = gridKey / 100;
-    int goalX = static_cast<int>(player.getX()) / CELL_SIZE;
-    int goalY = static_cast<int>(player.getY()) / CELL_SIZE;
-
-    std::vector<std::pair<int, int>> path;
-    if (startX == goalX && startY == goalY) return path;
-
-    // Define a custom comparator for the priority queue
-    auto compare = [](const std::tuple<int, int, int, int, std::vector<std::pair<int, int>>>& a,
-                    const std::tuple<int, int, int, int, std::vector<std::pair<int, int>>>& b) {
-        return std::get<0>(a) > std::get<0>(b); // Min-heap based on priority
-    };
-
-    // Declare the priority queue with the custom comparator
-    std::priority_queue<
-        std::tuple<int, int, int, int, std::vector<std::pair<int, int>>>,
-        std::vector<std::tuple<int, int, int, int, std::vector<std::pair<int, int>>>>,
-        decltype(compare)
-    > openSet(compare);
-
-    std::unordered_map<int, std::unordered_map<int, int>> costSoFar;
-    openSet.emplace(0, startX, startY, 0, path);
-    costSoFar[startX][startY] = 0;
-
-    while (!openSet.empty()) {
-        auto [priority, x, y, cost, path] = openSet.top();
-        openSet.pop();
+void PathfindingManager::clear() {
+    sharedPaths.clear();
+    goalX = -1;
+    goalY = -1;
+}
 
-        if (x == goalX && y == goalY) return path;
+uint32_t PathfindingManager::nextRefreshPhase(uint32_t interval) {
+    // A stride coprime to any even interval visits every phase before repeating
+    return (refreshPhases++ * 997u) % interval;
+}
 
-        static const std::vector<std::pair<int, int>> directions = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
-        for (const auto& [dx, dy] : directions) {
-            int nextX = x + dx;
-            int nextY = y + dy;
-            int newCost = cost + 1;
+SharedPath PathfindingManager::calculateSharedPath(Player& player, SimulationContext& context, int gridKey) {
+    PROFILE_ZONE("PathfindingManager::calculateSharedPath");
+    auto& dungeonMaze = context.getDungeonMaze();
+    int startX = gridKey % 100;
+    int startY = gridKey / 100;
+    int playerX = static_cast<int>(player.getX()) / CELL_SIZE;
+    int playerY = static_cast<int>(player.getY()) / CELL_SIZE;
 
-            if (nextX >= 0 && nextX < dungeonMaze[0].size() && nextY >= 0 && nextY < dungeonMaze.size() && dungeonMaze[nextY][nextX] != -1) {
-                if (!costSoFar.count(nextX) || !costSoFar[nextX].count(nextY) || newCost < costSoFar[nextX][nextY]) {
-                    costSoFar[nextX][nextY] = newCost;
-                    int priority = newCost + abs(nextX - goalX) + abs(nextY - goalY);
-                    auto newPath = path;
-                    newPath.emplace_back(nextX, nextY);
-                    openSet.emplace(priority, nextX, nextY, newCost, newPath);
-                }
-            }
-        }
+    if (playerX != goalX || playerY != goalY) {
+        distancesToGoal(dungeonMaze, playerX, playerY, goalDistances);
+        goalX = playerX;
+        goalY = playerY;
     }
 
-    return {};
+    return std::make_shared<const std::vector<std::pair<int, int>>>(pathDownDistances(goalDistances, startX, startY));
 }
 
 int PathfindingManager::calculateGridKey(int x, int y) {
@@ -4,18 +4,43 @@
 #include <vector>
 #include <unordered_map>
 #include <utility>
+#include <memory>
+#include <cstdint>
+#include "Grid.h"
 
 class Player; // Forward declaration
-class Game; // Forward declaration
+class SimulationContext; // Forward declaration
 class Enemy; // Forward declaration
 
+// Maze cells to walk through, shared between every enemy that asked from the
+// same cell rather than copied into each of them
+using SharedPath = std::shared_ptr<const std::vector<std::pair<int, int>>>;
+
 class PathfindingManager {
 public:
-    std::vector<std::pair<int, int>> getSharedPathToPlayer(Player& player, Game& game, Enemy& enemy);
+    SharedPath getSharedPathToPlayer(Player& player, SimulationContext& context, Enemy& enemy);
+    void clear();  // Cached paths are stale once the maze changes under them
+
+    // Where in the refresh interval the next enemy refreshes its path, spread
+    // so enemies spawned together don't all refresh on the same step
+    uint32_t nextRefreshPhase(uint32_t interval);
+
+    // Shared path lookups so far, and how many were answered from the cache
+    unsigned long getLookups() const { return lookups; }
+    unsigned long getCacheHits() const { return cacheHits; }
 
 private:
-    std::unordered_map<int, std::vector<std::pair<int, int>>> sharedPaths;
-    std::vector<std::pair<int, int>> calculateSharedPath(Player& player, Game& game, int gridKey);
+    std::unordered_map<int, SharedPath> sharedPaths;
+    unsigned long lookups = 0;
+    unsigned long cacheHits = 0;
+    uint32_t refreshPhases = 0;
+    SharedPath calculateSharedPath(Player& player, SimulationContext& context, int gridKey);
+
+    // Distances to the cell the last missed paths led to; every miss while
+    // the player stays in that cell is a walk down them rather than a search
+    Grid<int> goalDistances;
+    int goalX = -1;
+    int goalY = -1;
 
     int calculateGridKey(int x, int y);
 };
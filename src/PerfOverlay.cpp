@@ -0,0 +1,53 @@
+#include "PerfOverlay.h"
+#include "Profiler.h"
+#include <algorithm>
+
+PerfOverlay::PerfOverlay()
+    : visible(false), enabledProfiler(false), lastFrameEnd(0), frameMs(), sortedMs(), sampleCount(0), nextSample(0), totalMs(0.0f) {}
+
+void PerfOverlay::toggle() {
+    visible = !visible;
+
+    if (visible) {
+        // Stats start over so the numbers describe what is on screen now
+        sampleCount = 0;
+        nextSample = 0;
+        totalMs = 0.0f;
+        lastFrameEnd = Profiler::getLastFrame().endNs;
+        if (!Profiler::isEnabled()) {
+            Profiler::setEnabled(true);
+            enabledProfiler = true;
+        }
+    } else if (enabledProfiler) {
+        Profiler::setEnabled(false);
+        enabledProfiler = false;
+    }
+}
+
+void PerfOverlay::sampleFrame() {
+    const ProfileFrame& frame = Profiler::getLastFrame();
+    if (frame.endNs == lastFrameEnd) return;
+    lastFrameEnd = frame.endNs;
+
+    frameMs[nextSample] = (frame.endNs - frame.startNs) / 1000000.0f;
+    nextSample = (nextSample + 1) % FRAME_HISTORY;
+    sampleCount = std::min(sampleCount + 1, FRAME_HISTORY);
+
+    std::copy(frameMs, frameMs + sampleCount, sortedMs);
+    std::sort(sortedMs, sortedMs + sampleCount);
+    totalMs = 0.0f;
+    for (int i = 0; i < sampleCount; ++i) {
+        totalMs += sortedMs[i];
+    }
+}
+
+float PerfOverlay::getPercentileMs(int percentile) const {
+    if (sampleCount == 0) return 0.0f;
+    int index = std::min(sampleCount - 1, sampleCount * percentile / 100);
+    return sortedMs[index];
+}
+
+float PerfOverlay::getAverageFps() const {
+    if (sampleCount == 0 || totalMs <= 0.0f) return 0.0f;
+    return sampleCount * 1000.0f / totalMs;
+}
@@ -0,0 +1,37 @@
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include <cstdint>
+
+// Rolling frame-time statistics behind the F3 overlay. Frames come from the
+// profiler, which the overlay switches on while it is visible; storage is
+// fixed so sampling and the percentile sort never allocate.
+class PerfOverlay {
+public:
+    static constexpr int FRAME_HISTORY = 240;   // About four seconds at 60 FPS
+
+    PerfOverlay();
+
+    void toggle();
+    bool isVisible() const { return visible; }
+
+    // Picks up the profiler's last finished frame, once per frame
+    void sampleFrame();
+
+    float getPercentileMs(int percentile) const;   // 50, 95 or 99
+    float getAverageFps() const;
+    int getSampleCount() const { return sampleCount; }
+
+private:
+    bool visible;
+    bool enabledProfiler;       // Profiling was off before the overlay turned it on
+    uint64_t lastFrameEnd;
+
+    float frameMs[FRAME_HISTORY];
+    float sortedMs[FRAME_HISTORY];
+    int sampleCount;
+    int nextSample;
+    float totalMs;
+};
+
+#endif
@@ -2,26 +2,41 @@
 #define PLAYER_H
 
 #include "Entity.h"
+#include "SlotMap.h"
 #include <vector>
 #include <memory>
 
-// Forward declaration of Game class
-class Game;
+class Enemy;
+class SimulationContext;
+
+// Player actions, independent of the keys and buttons bound to them
+enum class PlayerInput {
+    Slash,
+    CastSpell,
+    StartRunning,
+    StopRunning,
+    DrawBow,        // Held to aim; the arrow flies on ReleaseBow
+    ReleaseBow,
+    StartThrust,
+    EndThrust
+};
 
 class Player : public Entity {
 public:
-    Player(float p_x, float p_y, SDL_Texture* p_tex, int numFrames, float animationSpeed);
+    Player(EntityStates& states, float p_x, float p_y, SpriteSheetId p_sheet, int numFrames, float animationSpeed);
 
-    void handleInput(const SDL_Event& event) override;
-    void update(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities, Game& game);
+    void handleInput(PlayerInput input);
+    void update(float deltaTime, SlotMap<Enemy>& enemies, SimulationContext& context);
 
     int getThrustRange() const override;
-    SDL_Rect getAttackBoundingBox() const override;
+    Rect getAttackBoundingBox() const override;
 
     static const int INITIAL_HEALTH = 100;
     static const int INITIAL_STAMINA = 100;
     static const int THRUST_DAMAGE = 15;
     static const int SPELL_DAMAGE = 35;
+    static const int SPELL_DURATION = 4000;
+    static constexpr float SPELL_SPEED = 200.0f;
     static const int SLASH_DAMAGE = 25;
     static const int ARROW_DAMAGE = 20;
 
@@ -31,8 +46,9 @@ public:
     bool getIsDead() const { return isDead; }
     void setIsDead(bool dead) { isDead = dead; }
 
-    void updateSpellPosition(float deltaTime, std::vector<std::unique_ptr<Entity>>& entities, Game& game) override;
-    void updateArrowPosition(float deltaTime, const std::vector<std::vector<int>>& dungeonMaze, int cellSize);
+    // Set by handleInput, taken by Game which fires into the projectile system
+    bool takeSpellRequest();
+    bool takeArrowRequest(Direction& direction);
 
     void setDeathAnimationFinished(bool finished) { deathAnimationFinished = finished; }
     bool isDeathAnimationFinished() const;
@@ -41,8 +57,6 @@ public:
     void useStamina(float amount);
     void regenerateStamina(float deltaTime);
 
-    void deactivateSpell();
-
     void heal(int amount);
 
 private:
@@ -50,29 +64,15 @@ private:
     bool deathAnimationFinished;
     float stamina;
 
-    float spellDirX;
-    float spellDirY;
+    bool spellRequested;
+    bool arrowRequested;
+    Direction arrowRequestDirection;
 
     void handleCooldowns(float deltaTime);
 
-    enum SpellState {
-        CURVED_TRAJECTORY,
-        BOUNCING
-    };
-
-    SpellState spellState;
-    Uint32 lastBounceTime;
-    float bounceDistance;
-
-    const Uint32 curveInterval = 3000;  // Time to return to curve after bounce (e.g., 3 seconds)
-    const float maxBounceDistance = 500.0f;
-
     static const float SPELL_COOLDOWN;
     static const float SLASH_COOLDOWN;
     static const float SHOOTING_COOLDOWN;
-
-    int bounceCount;
-    const int maxBounces = 3;
 };
 
 #endif
\ No newline at end of file
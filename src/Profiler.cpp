@@ -0,0 +1,156 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct ThreadBuffer {
+        uint32_t threadId;
+        const char* name;
+        std::atomic<uint64_t> written{0};   // Total zones ever recorded; the ring holds the latest
+        ProfileEvent events[Profiler::EVENTS_PER_THREAD];
+    };
+
+    const char* counterNames[PROFILE_COUNTER_COUNT] = {"draw_calls", "astar_expansions"};
+
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    // Only touched by the thread driving the game loop
+    std::vector<ProfileFrame> frameHistory(Profiler::FRAME_HISTORY);
+    uint64_t framesWritten = 0;
+
+    // Registered on the thread's first zone and kept until exit, so zones
+    // from threads that have already finished still make it into the trace
+    ThreadBuffer& threadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = threadBuffers.back().get();
+            buffer->threadId = static_cast<uint32_t>(threadBuffers.size());
+            buffer->name = nullptr;
+        }
+        return *buffer;
+    }
+}
+
+void Profiler::recordZone(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % EVENTS_PER_THREAD] = {name, startNs, endNs};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const char* name) {
+    if (!isEnabled()) return;
+    threadBuffer().name = name;
+}
+
+void Profiler::beginFrame() {
+    frameStart = isEnabled() ? now() : 0;
+}
+
+void Profiler::endFrame() {
+    if (!frameStart) return;
+
+    ProfileFrame frame;
+    frame.startNs = frameStart;
+    frame.endNs = now();
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+        frame.counters[i] = counters[i].exchange(0, std::memory_order_relaxed);
+    }
+    recordZone("Frame", frame.startNs, frame.endNs);
+
+    frameHistory[framesWritten % FRAME_HISTORY] = frame;
+    framesWritten++;
+    lastFrame = frame;
+    frameStart = 0;
+}
+
+double Profiler::getZoneMs(const char* name) {
+    if (!lastFrame.endNs) return 0.0;
+
+    // Zones land in the ring in the order they close, so walk back from the
+    // newest until the ring is older than the frame
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t written = buffer.written.load(std::memory_order_relaxed);
+    uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+    uint64_t totalNs = 0;
+    for (uint64_t i = written; i > first; --i) {
+        const ProfileEvent& event = buffer.events[(i - 1) % EVENTS_PER_THREAD];
+        if (event.endNs < lastFrame.startNs) break;
+        if (event.endNs <= lastFrame.endNs && std::strcmp(event.name, name) == 0) {
+            totalNs += event.endNs - event.startNs;
+        }
+    }
+    return totalNs / 1000000.0;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // Timestamps are written relative to the earliest surviving event
+    uint64_t origin = UINT64_MAX;
+    for (const auto& buffer : threadBuffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < written; ++i) {
+            origin = std::min(origin, buffer->events[i % EVENTS_PER_THREAD].startNs);
+        }
+    }
+    if (origin == UINT64_MAX) origin = 0;
+
+    // Trace-event timestamps are microseconds
+    auto micros = [origin](uint64_t ns) { return (ns - std::min(ns, origin)) / 1000.0; };
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool firstEvent = true;
+    auto separator = [&file, &firstEvent]() {
+        if (!firstEvent) file << ",\n";
+        firstEvent = false;
+    };
+
+    for (const auto& buffer : threadBuffers) {
+        if (buffer->name) {
+            separator();
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"args\":{\"name\":\"" << buffer->name << "\"}}";
+        }
+
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < written; ++i) {
+            const ProfileEvent& event = buffer->events[i % EVENTS_PER_THREAD];
+            separator();
+            file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"ts\":" << micros(event.startNs) << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0 << "}";
+        }
+    }
+
+    uint64_t firstFrame = framesWritten > FRAME_HISTORY ? framesWritten - FRAME_HISTORY : 0;
+    for (uint64_t i = firstFrame; i < framesWritten; ++i) {
+        const ProfileFrame& frame = frameHistory[i % FRAME_HISTORY];
+        separator();
+        file << "{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << micros(frame.startNs) << ",\"args\":{";
+        for (int c = 0; c < PROFILE_COUNTER_COUNT; ++c) {
+            file << (c ? "," : "") << "\"" << counterNames[c] << "\":" << frame.counters[c];
+        }
+        file << "}}";
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
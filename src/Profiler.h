@@ -0,0 +1,100 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Per-frame totals the profiler keeps besides timed zones
+enum ProfileCounter {
+    COUNTER_DRAW_CALLS,         // Geometry and copy calls submitted to the renderer
+    COUNTER_ASTAR_EXPANSIONS,   // Nodes popped from an A* open set
+    PROFILE_COUNTER_COUNT
+};
+
+// One timed zone; name must be a string literal (only the pointer is kept)
+struct ProfileEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+// One finished frame with the counters accumulated during it
+struct ProfileFrame {
+    uint64_t startNs;
+    uint64_t endNs;
+    uint32_t counters[PROFILE_COUNTER_COUNT];
+};
+
+// Low-overhead instrumentation. Every thread that closes a zone gets its own
+// fixed ring buffer, so recording never locks or allocates after the first
+// zone on a thread; once a ring wraps, the oldest zones are overwritten.
+// Everything is off until setEnabled(true), at which point a disabled zone
+// costs one relaxed load. Call exportChromeTrace once the worker threads
+// have stopped; the file opens in chrome://tracing or Perfetto.
+class Profiler {
+public:
+    static constexpr uint32_t EVENTS_PER_THREAD = 1 << 16;
+    static constexpr uint32_t FRAME_HISTORY = 1 << 12;
+
+    static void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static void recordZone(const char* name, uint64_t startNs, uint64_t endNs);
+    static void setThreadName(const char* name);   // Label for the calling thread in the trace
+
+    static void count(ProfileCounter counter, uint32_t amount = 1) {
+        if (isEnabled()) counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // Frames are delimited by the thread driving the game loop
+    static void beginFrame();
+    static void endFrame();
+    static const ProfileFrame& getLastFrame() { return lastFrame; }
+
+    // Time the calling thread spent in zones with this name during the last frame
+    static double getZoneMs(const char* name);
+
+    static bool exportChromeTrace(const std::string& path);
+
+private:
+    static inline std::atomic<bool> enabled{false};
+    static inline std::atomic<uint32_t> counters[PROFILE_COUNTER_COUNT] = {};
+    static inline uint64_t frameStart = 0;
+    static inline ProfileFrame lastFrame = {};
+};
+
+// Times the enclosing scope
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* p_name) : name(p_name), startNs(Profiler::isEnabled() ? Profiler::now() : 0) {}
+    ~ProfileZone() {
+        if (startNs) Profiler::recordZone(name, startNs, Profiler::now());
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    uint64_t startNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PROFILER_DISABLED
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#else
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_COUNT(counter, amount) Profiler::count(counter, amount)
+#endif
+
+#endif
@@ -0,0 +1,341 @@
+#include "ProjectileSystem.h"
+#include "Clock.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "TileTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const int FRAME_SIZE = 64;          // Projectile sprites use the entity frame size
+const int SPELL_HIT_SIZE = 24;
+const float WALL_PADDING = 5.0f;    // Lets a spell start bouncing just before impact
+const float SPELL_CENTER = 38.0f;   // Offset from a spell's position to the centre of its glow
+const float ARROW_TIP_X = 32.0f;
+const float ARROW_TIP_Y = 64.0f;
+
+ProjectileSystem::ProjectileSystem()
+    : bucketStart(BROAD_PHASE_BUCKETS + 1, 0), bucketCursor(BROAD_PHASE_BUCKETS, 0) {}
+
+ProjectileHandle ProjectileSystem::fireArrow(Entity& shooter, Entity::Direction direction, int damage) {
+    float xOffset = 0;
+    float yOffset = 0;
+
+    switch (direction) {
+        case Entity::Up:
+            xOffset = FRAME_SIZE / 2;
+            yOffset = -FRAME_SIZE / 4;
+            break;
+        case Entity::Down:
+            xOffset = FRAME_SIZE / 2;
+            yOffset = FRAME_SIZE / 2 + 25;
+            break;
+        case Entity::Left:
+            xOffset = -FRAME_SIZE / 4;
+            yOffset = FRAME_SIZE / 2;
+            break;
+        case Entity::Right:
+            xOffset = FRAME_SIZE / 2 + 30;
+            yOffset = FRAME_SIZE / 2;
+            break;
+    }
+
+    int row = 20;
+    switch (direction) {
+        case Entity::Up:    row = 20; break;
+        case Entity::Left:  row = 21; break;
+        case Entity::Down:  row = 22; break;
+        case Entity::Right: row = 23; break;
+    }
+
+    Projectile arrow{};
+    arrow.kind = Projectile::Arrow;
+    arrow.owner = shooter.getType();
+    arrow.spriteSheet = shooter.getSpriteSheet();
+    arrow.spriteRow = row;
+    arrow.damage = damage;
+    arrow.x = shooter.getX() + xOffset;
+    arrow.y = shooter.getY() + yOffset;
+    arrow.prevX = arrow.x;
+    arrow.prevY = arrow.y;
+    arrow.speed = ARROW_SPEED;
+    arrow.direction = direction;
+    arrow.travelled = 0.0f;
+    arrow.maxDistance = ARROW_MAX_DISTANCE;
+    return pool.spawn(arrow);
+}
+
+ProjectileHandle ProjectileSystem::fireSpell(Entity& caster, float startX, float startY, float targetX, float targetY,
+                                             float speed, uint32_t duration, int damage, int spriteRow) {
+    Projectile spell{};
+    spell.kind = Projectile::Spell;
+    spell.owner = caster.getType();
+    spell.spriteSheet = caster.getSpriteSheet();
+    spell.spriteRow = spriteRow;
+    spell.damage = damage;
+    spell.x = startX;
+    spell.y = startY;
+    spell.prevX = startX;
+    spell.prevY = startY;
+    spell.speed = speed;
+    spell.targetX = targetX;
+    spell.targetY = targetY;
+    spell.startTime = SimulationClock::getTicks();
+    spell.duration = duration;
+    spell.state = Projectile::CurvedTrajectory;
+    return pool.spawn(spell);
+}
+
+void ProjectileSystem::savePreviousPositions() {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        Projectile& projectile = pool.live(i);
+        projectile.prevX = projectile.x;
+        projectile.prevY = projectile.y;
+    }
+}
+
+void ProjectileSystem::translate(float dx, float dy) {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        Projectile& projectile = pool.live(i);
+        projectile.x += dx;
+        projectile.y += dy;
+        projectile.prevX += dx;
+        projectile.prevY += dy;
+        projectile.targetX += dx;
+        projectile.targetY += dy;
+    }
+}
+
+void ProjectileSystem::update(float deltaTime, Player& player, SlotMap<Enemy>& enemies,
+                              const Grid<int>& dungeonMaze, std::vector<ProjectileHit>& hits) {
+    if (pool.size() == 0) return;
+
+    uint32_t currentTime = SimulationClock::getTicks();
+    broadPhaseBuilt = false;  // Built on the first player-owned query, skipped on enemy-only updates
+
+    for (size_t i = 0; i < pool.size();) {
+        Projectile& projectile = pool.live(i);
+
+        bool alive = projectile.kind == Projectile::Arrow
+            ? moveArrow(projectile, deltaTime, dungeonMaze)
+            : moveSpell(projectile, deltaTime, currentTime, player, enemies, dungeonMaze);
+
+        if (alive) {
+            Rect hitBox = getHitBox(projectile);
+            Entity* target = nullptr;
+
+            if (projectile.owner == Entity::PlayerEntity) {
+                target = queryBroadPhase(hitBox, enemies);
+            } else if (!player.getIsDead()) {
+                Rect playerBox = player.getBoundingBox();
+                if (rectsOverlap(hitBox, playerBox)) {
+                    target = &player;
+                }
+            }
+
+            if (target) {
+                hits.push_back({projectile.kind, projectile.owner, target, projectile.damage});
+                alive = false;
+            }
+        }
+
+        if (alive) {
+            ++i;
+        } else {
+            pool.despawnLive(i);  // The last live projectile moves into slot i
+        }
+    }
+}
+
+bool ProjectileSystem::moveArrow(Projectile& arrow, float deltaTime, const Grid<int>& dungeonMaze) {
+    float distance = arrow.speed * deltaTime;
+    arrow.travelled += distance;
+
+    switch (arrow.direction) {
+        case Entity::Up:    arrow.y -= distance; break;
+        case Entity::Down:  arrow.y += distance; break;
+        case Entity::Left:  arrow.x -= distance; break;
+        case Entity::Right: arrow.x += distance; break;
+    }
+
+    return arrow.travelled < arrow.maxDistance && !isWallAt(arrow.x + ARROW_TIP_X, arrow.y + ARROW_TIP_Y, dungeonMaze);
+}
+
+bool ProjectileSystem::moveSpell(Projectile& spell, float deltaTime, uint32_t currentTime, Player& player,
+                                 SlotMap<Enemy>& enemies, const Grid<int>& dungeonMaze) {
+    if (currentTime - spell.startTime > spell.duration) {
+        return false;
+    }
+
+    // Switch back to the curved trajectory once the spell has bounced for a while
+    if (spell.state == Projectile::Bouncing && currentTime - spell.lastBounceTime > BOUNCE_RECOVERY_TIME) {
+        spell.state = Projectile::CurvedTrajectory;
+    }
+
+    if (spell.state == Projectile::CurvedTrajectory) {
+        // Player spells home on the closest enemy, enemy spells on the player
+        if (spell.owner == Entity::PlayerEntity) {
+            float minDistance = std::numeric_limits<float>::max();
+            for (auto& enemy : enemies) {
+                float distance = std::hypot(spell.x - enemy.getX(), spell.y - enemy.getY());
+                if (distance < minDistance) {
+                    minDistance = distance;
+                    spell.targetX = enemy.getX();
+                    spell.targetY = enemy.getY();
+                }
+            }
+        } else if (!player.getIsDead()) {
+            spell.targetX = player.getX();
+            spell.targetY = player.getY();
+        } else {
+            return false;
+        }
+
+        float dx = spell.targetX - spell.x;
+        float dy = spell.targetY - spell.y;
+        float distance = std::hypot(dx, dy);
+
+        if (distance <= 5.0f) {
+            return false;
+        }
+
+        float curve = sin(currentTime * 0.001f);
+        float controlPointX = (spell.x + spell.targetX) / 2 + curve * 50;
+        float controlPointY = (spell.y + spell.targetY) / 2 + curve * 50;
+
+        // Step along the quadratic curve towards the target
+        float t = spell.speed * deltaTime / distance;
+        spell.x = (1 - t) * (1 - t) * spell.x + 2 * (1 - t) * t * controlPointX + t * t * spell.targetX;
+        spell.y = (1 - t) * (1 - t) * spell.y + 2 * (1 - t) * t * controlPointY + t * t * spell.targetY;
+
+        if (isSpellCollidingWithWall(spell.x + spell.dirX * WALL_PADDING, spell.y + spell.dirY * WALL_PADDING, dungeonMaze)) {
+            spell.state = Projectile::Bouncing;
+            spell.lastBounceTime = currentTime;
+
+            float directionDx = spell.targetX - spell.x;
+            float directionDy = spell.targetY - spell.y;
+            float directionDistance = std::hypot(directionDx, directionDy);
+            if (directionDistance > 0) {
+                spell.dirX = directionDx / directionDistance;
+                spell.dirY = directionDy / directionDistance;
+            }
+        }
+        return true;
+    }
+
+    float newX = spell.x + spell.dirX * spell.speed * deltaTime;
+    float newY = spell.y + spell.dirY * spell.speed * deltaTime;
+
+    if (isSpellCollidingWithWall(newX + spell.dirX * WALL_PADDING, newY + spell.dirY * WALL_PADDING, dungeonMaze)) {
+        // Reflect off whichever axis hit the wall
+        if (isSpellCollidingWithWall(newX + spell.dirX * WALL_PADDING, spell.y, dungeonMaze)) {
+            spell.dirX = -spell.dirX;
+        }
+        if (isSpellCollidingWithWall(spell.x, newY + spell.dirY * WALL_PADDING, dungeonMaze)) {
+            spell.dirY = -spell.dirY;
+        }
+
+        newX = spell.x + spell.dirX * spell.speed * deltaTime;
+        newY = spell.y + spell.dirY * spell.speed * deltaTime;
+
+        spell.lastBounceTime = currentTime;
+        if (++spell.bounceCount >= MAX_BOUNCES) {
+            return false;
+        }
+    }
+
+    spell.x = newX;
+    spell.y = newY;
+    return true;
+}
+
+bool ProjectileSystem::isSpellCollidingWithWall(float x, float y, const Grid<int>& dungeonMaze) {
+    return isWallAt(x + SPELL_CENTER, y + SPELL_CENTER, dungeonMaze);
+}
+
+bool ProjectileSystem::isWallAt(float x, float y, const Grid<int>& dungeonMaze) {
+    int mazeX = static_cast<int>(x) / CELL_SIZE;
+    int mazeY = static_cast<int>(y) / CELL_SIZE;
+
+    if (!dungeonMaze.inBounds(mazeX, mazeY)) {
+        return true;
+    }
+
+    return dungeonCellDescriptor(dungeonMaze[mazeY][mazeX]).solid;
+}
+
+Rect ProjectileSystem::getHitBox(const Projectile& projectile) {
+    if (projectile.kind == Projectile::Arrow) {
+        return {static_cast<int>(projectile.x), static_cast<int>(projectile.y), FRAME_SIZE, FRAME_SIZE};
+    }
+    return {static_cast<int>(projectile.x), static_cast<int>(projectile.y), SPELL_HIT_SIZE, SPELL_HIT_SIZE};
+}
+
+Rect ProjectileSystem::getFrame(const Projectile& projectile) {
+    if (projectile.kind == Projectile::Arrow) {
+        return {0, projectile.spriteRow * FRAME_SIZE, FRAME_SIZE, FRAME_SIZE};
+    }
+    int frameIndex = (SimulationClock::getTicks() / 50) % 6;  // 6 frames for the spell animation
+    return {frameIndex * FRAME_SIZE, projectile.spriteRow * FRAME_SIZE, FRAME_SIZE, FRAME_SIZE};
+}
+
+int ProjectileSystem::bucketOf(int cellX, int cellY) {
+    uint32_t hash = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+    return hash & (BROAD_PHASE_BUCKETS - 1);
+}
+
+static int floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+void ProjectileSystem::buildBroadPhase(SlotMap<Enemy>& enemies) {
+    // Counting sort of enemy indices into hashed grid buckets: count, prefix-sum, scatter
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        Rect box = enemies[i].getBoundingBox();
+        for (int cy = floorDiv(box.y, BROAD_PHASE_CELL); cy <= floorDiv(box.y + box.h - 1, BROAD_PHASE_CELL); ++cy) {
+            for (int cx = floorDiv(box.x, BROAD_PHASE_CELL); cx <= floorDiv(box.x + box.w - 1, BROAD_PHASE_CELL); ++cx) {
+                bucketStart[bucketOf(cx, cy) + 1]++;
+            }
+        }
+    }
+
+    for (int b = 0; b < BROAD_PHASE_BUCKETS; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+        bucketCursor[b] = bucketStart[b];
+    }
+    bucketEntries.resize(bucketStart[BROAD_PHASE_BUCKETS]);
+
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        Rect box = enemies[i].getBoundingBox();
+        for (int cy = floorDiv(box.y, BROAD_PHASE_CELL); cy <= floorDiv(box.y + box.h - 1, BROAD_PHASE_CELL); ++cy) {
+            for (int cx = floorDiv(box.x, BROAD_PHASE_CELL); cx <= floorDiv(box.x + box.w - 1, BROAD_PHASE_CELL); ++cx) {
+                bucketEntries[bucketCursor[bucketOf(cx, cy)]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+Enemy* ProjectileSystem::queryBroadPhase(const Rect& area, SlotMap<Enemy>& enemies) {
+    if (!broadPhaseBuilt) {
+        buildBroadPhase(enemies);
+        broadPhaseBuilt = true;
+    }
+
+    for (int cy = floorDiv(area.y, BROAD_PHASE_CELL); cy <= floorDiv(area.y + area.h - 1, BROAD_PHASE_CELL); ++cy) {
+        for (int cx = floorDiv(area.x, BROAD_PHASE_CELL); cx <= floorDiv(area.x + area.w - 1, BROAD_PHASE_CELL); ++cx) {
+            int bucket = bucketOf(cx, cy);
+            for (uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; ++e) {
+                Enemy& enemy = enemies[bucketEntries[e]];
+                if (enemy.isMarkedForRemoval()) continue;
+
+                Rect enemyBox = enemy.getBoundingBox();
+                if (rectsOverlap(area, enemyBox)) {
+                    return &enemy;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
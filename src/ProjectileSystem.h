@@ -0,0 +1,112 @@
+#ifndef PROJECTILESYSTEM_H
+#define PROJECTILESYSTEM_H
+
+#include <vector>
+#include <cstdint>
+#include "Entity.h"
+#include "FixedPool.h"
+#include "SlotMap.h"
+#include "Grid.h"
+
+class Player;
+class Enemy;
+
+const int MAX_PROJECTILES = 512;   // Arrows and spells in flight at once, across all casters
+
+// One arrow or spell in flight. Plain data so the pool can hold it in place.
+struct Projectile {
+    enum Kind { Arrow, Spell };
+    enum SpellState { CurvedTrajectory, Bouncing };
+
+    Kind kind;
+    Entity::Type owner;         // Side that fired it; it only hits the other side
+    SpriteSheetId spriteSheet;  // Caster's sheet
+    int spriteRow;
+    int damage;
+
+    float x, y;
+    float prevX, prevY;         // Position at the start of the simulation step
+    float speed;
+
+    // Arrows fly straight until they hit something or run out of range
+    Entity::Direction direction;
+    float travelled;
+    float maxDistance;
+
+    // Spells home on a target along a curve and bounce off walls
+    float targetX, targetY;
+    float dirX, dirY;
+    uint32_t startTime;
+    uint32_t duration;
+    SpellState state;
+    uint32_t lastBounceTime;
+    int bounceCount;
+};
+
+using ProjectileHandle = FixedPool<Projectile, MAX_PROJECTILES>::Handle;
+
+// A projectile that struck an entity this update; the projectile is already gone
+struct ProjectileHit {
+    Projectile::Kind kind;
+    Entity::Type owner;
+    Entity* target;
+    int damage;
+};
+
+// Owns every arrow and spell in flight. Firing and despawning never allocate,
+// all projectiles are advanced in one loop, and hits against enemies go
+// through a uniform-grid broad phase rebuilt at most once per update.
+class ProjectileSystem {
+public:
+    static constexpr float ARROW_SPEED = 400.0f;
+    static constexpr float ARROW_MAX_DISTANCE = 800.0f;
+    static const int MAX_BOUNCES = 10;
+    static const uint32_t BOUNCE_RECOVERY_TIME = 2000;   // ms before a bouncing spell curves again
+
+    ProjectileSystem();
+
+    // Both return an invalid handle when the pool is full
+    ProjectileHandle fireArrow(Entity& shooter, Entity::Direction direction, int damage);
+    ProjectileHandle fireSpell(Entity& caster, float startX, float startY, float targetX, float targetY,
+                               float speed, uint32_t duration, int damage, int spriteRow);
+
+    bool isAlive(ProjectileHandle handle) const { return pool.alive(handle); }
+    void savePreviousPositions();
+    void translate(float dx, float dy);     // Every projectile and its target, previous positions included
+    void clear() { pool.clear(); }
+
+    void update(float deltaTime, Player& player, SlotMap<Enemy>& enemies,
+                const Grid<int>& dungeonMaze, std::vector<ProjectileHit>& hits);
+
+    size_t size() const { return pool.size(); }
+    const Projectile& get(size_t i) const { return pool.live(i); }
+    static Rect getFrame(const Projectile& projectile);
+
+private:
+    static const int CELL_SIZE = 96;                // Dungeon maze cell, in pixels
+    static const int BROAD_PHASE_CELL = 128;
+    static const int BROAD_PHASE_BUCKETS = 1024;    // Power of two; cells hash into buckets
+
+    // Returns false once the projectile should despawn
+    bool moveArrow(Projectile& arrow, float deltaTime, const Grid<int>& dungeonMaze);
+    bool moveSpell(Projectile& spell, float deltaTime, uint32_t currentTime, Player& player,
+                   SlotMap<Enemy>& enemies, const Grid<int>& dungeonMaze);
+
+    static bool isWallAt(float x, float y, const Grid<int>& dungeonMaze);
+    static bool isSpellCollidingWithWall(float x, float y, const Grid<int>& dungeonMaze);
+    static Rect getHitBox(const Projectile& projectile);
+
+    void buildBroadPhase(SlotMap<Enemy>& enemies);
+    Enemy* queryBroadPhase(const Rect& area, SlotMap<Enemy>& enemies);
+    static int bucketOf(int cellX, int cellY);
+
+    FixedPool<Projectile, MAX_PROJECTILES> pool;
+
+    // Counting-sorted enemy indices per bucket; sized once, reused every update
+    std::vector<uint32_t> bucketStart;
+    std::vector<uint32_t> bucketCursor;
+    std::vector<uint32_t> bucketEntries;
+    bool broadPhaseBuilt = false;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include "Random.h"
+
+// splitmix64, the recommended way to expand a 64-bit seed into xoshiro state
+static uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void Random::reseed(uint64_t seed) {
+    uint64_t a = splitMix64(seed);
+    uint64_t b = splitMix64(seed);
+    state[0] = static_cast<uint32_t>(a);
+    state[1] = static_cast<uint32_t>(a >> 32);
+    state[2] = static_cast<uint32_t>(b);
+    state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+void RandomService::seed(uint64_t seed) {
+    masterSeed = seed;
+    uint64_t x = seed;
+    for (int i = 0; i < RANDOM_STREAM_COUNT; ++i) {
+        streams[i].reseed(splitMix64(x));
+    }
+}
+
+uint64_t RandomService::deriveSeed(RandomStream stream, uint64_t index) {
+    uint64_t x = masterSeed ^ (static_cast<uint64_t>(stream) << 56);
+    x = splitMix64(x) ^ index;
+    return splitMix64(x);
+}
@@ -0,0 +1,94 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+// xoshiro128** generator: four words of state, a handful of instructions per
+// number, and fully reproducible from a seed on every platform. Also usable as
+// a UniformRandomBitGenerator with the standard library.
+class Random {
+public:
+    using result_type = uint32_t;
+
+    explicit Random(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed);
+
+    uint32_t next() {
+        uint32_t result = rotl(state[1] * 5, 7) * 9;
+        uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 11);
+        return result;
+    }
+
+    // Uniform in [0, bound), without modulo bias
+    uint32_t nextBelow(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(next()) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = -bound % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next()) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Uniform in [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+
+    // Fisher-Yates; unlike std::shuffle the result doesn't depend on the standard library
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        auto count = std::distance(first, last);
+        for (auto i = count - 1; i > 0; --i) {
+            std::swap(first[i], first[nextBelow(static_cast<uint32_t>(i + 1))]);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() { return next(); }
+
+private:
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    uint32_t state[4];
+};
+
+// Independent streams so that, say, extra AI rolls never change maze layouts
+enum RandomStream {
+    RANDOM_MAZE,
+    RANDOM_SPAWN,
+    RANDOM_AI,
+    RANDOM_COMBAT,
+    RANDOM_STREAM_COUNT
+};
+
+// One master seed for the whole game; each system draws from its own stream.
+// Seeding with the same value reproduces maze layouts, spawns, AI and combat rolls.
+class RandomService {
+public:
+    static void seed(uint64_t masterSeed);
+    static uint64_t getSeed() { return masterSeed; }
+    static Random& stream(RandomStream stream) { return streams[stream]; }
+
+    // Seed for the index-th unit of work a stream drives, e.g. the maze of the
+    // index-th level. Lets work built off the game thread stay reproducible
+    // without sharing (and racing on) the stream itself.
+    static uint64_t deriveSeed(RandomStream stream, uint64_t index);
+
+private:
+    static inline uint64_t masterSeed = 0;
+    static inline Random streams[RANDOM_STREAM_COUNT];
+};
+
+#endif
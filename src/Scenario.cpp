@@ -0,0 +1,120 @@
+#include "Scenario.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+const char* const SCENARIO_NAMES[] = {
+    "outdoor-walk",     // Fast travel east across overworld chunks
+    "dungeon-0",
+    "dungeon-10",
+    "dungeon-50",
+    "spell-swarm",      // 200 enemies casting at an unkillable player
+    "endless-descent",  // Straight down the endless maze, streaming and rebasing as it goes
+};
+const int SCENARIO_COUNT = sizeof(SCENARIO_NAMES) / sizeof(SCENARIO_NAMES[0]);
+
+namespace {
+
+// Percentiles this close to the baseline are within timer and scheduler noise
+const double MIN_REGRESSION_MS = 0.05;
+
+double percentile(const std::vector<double>& sorted, int p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));  // Nearest rank
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+bool regressed(const char* label, double baseline, double current, double threshold) {
+    bool worse = current > baseline * (1.0 + threshold) && current - baseline > MIN_REGRESSION_MS;
+    printf("  %-11s %8.3f ms -> %8.3f ms%s\n", label, baseline, current, worse ? "  REGRESSED" : "");
+    return worse;
+}
+
+}
+
+ScenarioResult summarizeScenario(const std::string& name, std::vector<double> updateMs, std::vector<double> renderMs) {
+    std::sort(updateMs.begin(), updateMs.end());
+    std::sort(renderMs.begin(), renderMs.end());
+
+    ScenarioResult result;
+    result.name = name;
+    result.frames = static_cast<int>(updateMs.size());
+    result.updateP95Ms = percentile(updateMs, 95);
+    result.updateP99Ms = percentile(updateMs, 99);
+    result.renderP95Ms = percentile(renderMs, 95);
+    result.renderP99Ms = percentile(renderMs, 99);
+    return result;
+}
+
+bool saveScenarioBaseline(const std::string& path, const std::vector<ScenarioResult>& results) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open scenario baseline " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    file << "{\n  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScenarioResult& r = results[i];
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "    {\"name\": \"%s\", \"frames\": %d, \"update_p95_ms\": %.4f, \"update_p99_ms\": %.4f, "
+                 "\"render_p95_ms\": %.4f, \"render_p99_ms\": %.4f}%s\n",
+                 r.name.c_str(), r.frames, r.updateP95Ms, r.updateP99Ms, r.renderP95Ms, r.renderP99Ms,
+                 i + 1 < results.size() ? "," : "");
+        file << line;
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+bool loadScenarioBaseline(const std::string& path, std::vector<ScenarioResult>& results) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open scenario baseline " << path << std::endl;
+        return false;
+    }
+
+    results.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find("\"name\"") == std::string::npos) continue;
+
+        char name[64];
+        ScenarioResult r;
+        if (sscanf(line.c_str(),
+                   " {\"name\": \"%63[^\"]\", \"frames\": %d, \"update_p95_ms\": %lf, \"update_p99_ms\": %lf, "
+                   "\"render_p95_ms\": %lf, \"render_p99_ms\": %lf",
+                   name, &r.frames, &r.updateP95Ms, &r.updateP99Ms, &r.renderP95Ms, &r.renderP99Ms) != 6) {
+            std::cerr << "Malformed scenario baseline line in " << path << ": " << line << std::endl;
+            return false;
+        }
+        r.name = name;
+        results.push_back(r);
+    }
+    return true;
+}
+
+bool compareScenarioResults(const std::vector<ScenarioResult>& baseline,
+                            const std::vector<ScenarioResult>& current, double threshold) {
+    bool passed = true;
+    for (const ScenarioResult& result : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+                               [&result](const ScenarioResult& b) { return b.name == result.name; });
+        if (it == baseline.end()) {
+            printf("%s: no baseline, skipped\n", result.name.c_str());
+            continue;
+        }
+
+        printf("%s (%d frames):\n", result.name.c_str(), result.frames);
+        bool worse = false;
+        worse |= regressed("update p95", it->updateP95Ms, result.updateP95Ms, threshold);
+        worse |= regressed("update p99", it->updateP99Ms, result.updateP99Ms, threshold);
+        worse |= regressed("render p95", it->renderP95Ms, result.renderP95Ms, threshold);
+        worse |= regressed("render p99", it->renderP99Ms, result.renderP99Ms, threshold);
+        if (worse) passed = false;
+    }
+    return passed;
+}
@@ -0,0 +1,31 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <string>
+#include <vector>
+
+// Scripted scenarios Game::runScenario can play, in the order "all" runs them
+extern const char* const SCENARIO_NAMES[];
+extern const int SCENARIO_COUNT;
+
+// Per-frame CPU time of one scenario run, reduced to the percentiles a
+// baseline file keeps
+struct ScenarioResult {
+    std::string name;
+    int frames;
+    double updateP95Ms, updateP99Ms;
+    double renderP95Ms, renderP99Ms;
+};
+
+ScenarioResult summarizeScenario(const std::string& name, std::vector<double> updateMs, std::vector<double> renderMs);
+
+// Baselines are small JSON files, one scenario object per line
+bool saveScenarioBaseline(const std::string& path, const std::vector<ScenarioResult>& results);
+bool loadScenarioBaseline(const std::string& path, std::vector<ScenarioResult>& results);
+
+// Prints every percentile next to its baseline. Returns false if any grew by
+// more than `threshold` (0.1 = 10%) and by more than timer noise.
+bool compareScenarioResults(const std::vector<ScenarioResult>& baseline,
+                            const std::vector<ScenarioResult>& current, double threshold);
+
+#endif
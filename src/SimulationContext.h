@@ -0,0 +1,19 @@
+#ifndef SIMULATIONCONTEXT_H
+#define SIMULATIONCONTEXT_H
+
+#include "Grid.h"
+
+class Entity;
+
+// What entities ask of the level they live in. Game implements it; entity
+// code only sees this interface, so it builds without Game.h or SDL.
+class SimulationContext {
+public:
+    virtual ~SimulationContext() = default;
+
+    virtual bool isWall(float x, float y) = 0;
+    virtual const Grid<int>& getDungeonMaze() const = 0;
+    virtual void applyDamage(Entity& attacker, Entity& target, int damage) = 0;
+};
+
+#endif
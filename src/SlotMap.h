@@ -0,0 +1,134 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+// Densely packed container with stable, generation-checked handles.
+// Elements live contiguously in insertion-ish order so systems can iterate
+// them like a vector; removal swaps the last element into the hole, so raw
+// pointers and references are only valid until the next removal. Handles
+// stay valid until their element is removed and never alias a later one.
+template <typename T>
+class SlotMap {
+public:
+    struct Handle {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    template <typename... Args>
+    Handle emplace(Args&&... args) {
+        uint32_t slotIndex;
+        if (!freeSlots.empty()) {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        }
+
+        dense.emplace_back(std::forward<Args>(args)...);
+        denseToSlot.push_back(slotIndex);
+        slots[slotIndex].denseIndex = static_cast<uint32_t>(dense.size() - 1);
+        return {slotIndex, slots[slotIndex].generation};
+    }
+
+    bool contains(Handle handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+    }
+
+    T* get(Handle handle) {
+        return contains(handle) ? &dense[slots[handle.index].denseIndex] : nullptr;
+    }
+    const T* get(Handle handle) const {
+        return contains(handle) ? &dense[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // Handle of the element at a position in iteration order
+    Handle handleAt(size_t position) const {
+        uint32_t slotIndex = denseToSlot[position];
+        return {slotIndex, slots[slotIndex].generation};
+    }
+
+    void remove(Handle handle) {
+        if (contains(handle)) removeAt(slots[handle.index].denseIndex);
+    }
+
+    template <typename Predicate>
+    size_t removeIf(Predicate predicate) {
+        size_t removed = 0;
+        for (size_t i = 0; i < dense.size();) {
+            if (predicate(dense[i])) {
+                removeAt(static_cast<uint32_t>(i));  // Re-check i, the last element moved here
+                removed++;
+            } else {
+                ++i;
+            }
+        }
+        return removed;
+    }
+
+    void clear() {
+        for (uint32_t slotIndex : denseToSlot) {
+            slots[slotIndex].generation++;
+            freeSlots.push_back(slotIndex);
+        }
+        dense.clear();
+        denseToSlot.clear();
+    }
+
+    void reserve(size_t capacity) {
+        dense.reserve(capacity);
+        denseToSlot.reserve(capacity);
+        slots.reserve(capacity);
+    }
+
+    size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+
+    T& operator[](size_t position) { return dense[position]; }
+    const T& operator[](size_t position) const { return dense[position]; }
+
+    iterator begin() { return dense.begin(); }
+    iterator end() { return dense.end(); }
+    const_iterator begin() const { return dense.begin(); }
+    const_iterator end() const { return dense.end(); }
+
+private:
+    struct Slot {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    void removeAt(uint32_t position) {
+        uint32_t slotIndex = denseToSlot[position];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+
+        if (position != last) {
+            dense[position] = std::move(dense[last]);
+            denseToSlot[position] = denseToSlot[last];
+            slots[denseToSlot[position]].denseIndex = position;
+        }
+        dense.pop_back();
+        denseToSlot.pop_back();
+
+        slots[slotIndex].generation++;  // Invalidates outstanding handles
+        freeSlots.push_back(slotIndex);
+    }
+
+    std::vector<T> dense;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
+
+#endif // SLOTMAP_H
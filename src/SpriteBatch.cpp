@@ -0,0 +1,94 @@
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <functional>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "SpriteBatch needs SDL 2.0.18 or newer for SDL_RenderGeometry"
+#endif
+
+// Layers whose sprites overlap each other in ways that depend on draw order
+// (the player and enemies); these are never regrouped by texture
+static bool keepsSubmissionOrder(int layer) {
+    return layer == LAYER_ENTITIES;
+}
+
+SpriteBatch::SpriteBatch(SDL_Renderer* p_renderer) : renderer(p_renderer), lastDrawCalls(0) {}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dest, int layer, SDL_Color tint) {
+    if (!texture || src.w <= 0 || src.h <= 0) return;
+
+    int width = 1, height = 1;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    float invW = 1.0f / width;
+    float invH = 1.0f / height;
+
+    Quad quad;
+    quad.layer = layer;
+    quad.texture = texture;
+    quad.dest = {static_cast<float>(dest.x), static_cast<float>(dest.y), static_cast<float>(dest.w), static_cast<float>(dest.h)};
+    quad.uv = {src.x * invW, src.y * invH, src.w * invW, src.h * invH};
+    quad.color = tint;
+    quads.push_back(quad);
+}
+
+void SpriteBatch::fillRect(const SDL_Rect& dest, SDL_Color color, int layer) {
+    Quad quad;
+    quad.layer = layer;
+    quad.texture = nullptr;
+    quad.dest = {static_cast<float>(dest.x), static_cast<float>(dest.y), static_cast<float>(dest.w), static_cast<float>(dest.h)};
+    quad.uv = {0.0f, 0.0f, 0.0f, 0.0f};
+    quad.color = color;
+    quads.push_back(quad);
+}
+
+void SpriteBatch::flush() {
+    PROFILE_ZONE("SpriteBatch::flush");
+    lastDrawCalls = 0;
+    if (quads.empty()) return;
+
+    // Stable so sprites sharing a layer and texture keep their submission order.
+    // Order-sensitive layers are left as submitted and only batch where
+    // adjacent quads happen to share a texture.
+    std::stable_sort(quads.begin(), quads.end(), [](const Quad& a, const Quad& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (keepsSubmissionOrder(a.layer)) return false;
+        return std::less<SDL_Texture*>()(a.texture, b.texture);
+    });
+
+    SDL_Texture* current = quads.front().texture;
+    for (const auto& quad : quads) {
+        if (quad.texture != current) {
+            submit(current);
+            current = quad.texture;
+        }
+
+        int base = static_cast<int>(vertices.size());
+        float x0 = quad.dest.x, y0 = quad.dest.y;
+        float x1 = x0 + quad.dest.w, y1 = y0 + quad.dest.h;
+        float u0 = quad.uv.x, v0 = quad.uv.y;
+        float u1 = u0 + quad.uv.w, v1 = v0 + quad.uv.h;
+
+        vertices.push_back({{x0, y0}, quad.color, {u0, v0}});
+        vertices.push_back({{x1, y0}, quad.color, {u1, v0}});
+        vertices.push_back({{x1, y1}, quad.color, {u1, v1}});
+        vertices.push_back({{x0, y1}, quad.color, {u0, v1}});
+
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+    submit(current);
+
+    quads.clear();
+}
+
+void SpriteBatch::submit(SDL_Texture* texture) {
+    if (vertices.empty()) return;
+
+    SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+    lastDrawCalls++;
+    PROFILE_COUNT(COUNTER_DRAW_CALLS, 1);
+
+    vertices.clear();
+    indices.clear();
+}
@@ -0,0 +1,40 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "SpriteLayer.h"
+
+// Collects textured quads and solid rectangles for a frame and submits them
+// with SDL_RenderGeometry, one call per run of quads sharing a texture.
+class SpriteBatch {
+public:
+    SpriteBatch(SDL_Renderer* p_renderer);
+
+    void draw(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dest, int layer, SDL_Color tint = {255, 255, 255, 255});
+    void fillRect(const SDL_Rect& dest, SDL_Color color, int layer);
+
+    // Sorts the queued quads by layer (and by texture, except in LAYER_ENTITIES) and renders them
+    void flush();
+
+    size_t getLastDrawCalls() const { return lastDrawCalls; }
+
+private:
+    struct Quad {
+        int layer;
+        SDL_Texture* texture;  // nullptr for solid rectangles
+        SDL_FRect dest;
+        SDL_FRect uv;
+        SDL_Color color;
+    };
+
+    void submit(SDL_Texture* texture);
+
+    SDL_Renderer* renderer;
+    std::vector<Quad> quads;
+    std::vector<SDL_Vertex> vertices;  // Reused between flushes
+    std::vector<int> indices;
+    size_t lastDrawCalls;
+};
+
+#endif // SPRITEBATCH_H
@@ -0,0 +1,19 @@
+#ifndef SPRITELAYER_H
+#define SPRITELAYER_H
+
+// Draw layers, lowest first. Within a layer sprites are grouped by texture,
+// so draw order is only guaranteed between layers (and per texture), except
+// in LAYER_ENTITIES, which is drawn in submission order.
+enum SpriteLayer {
+    LAYER_BACKGROUND = 0,
+    LAYER_GROUND,
+    LAYER_GROUND_DETAIL,
+    LAYER_ENTITIES,
+    LAYER_EFFECTS,
+    LAYER_OVERLAY,
+    LAYER_HUD,
+    LAYER_HUD_OVERLAY,
+    LAYER_TEXT
+};
+
+#endif
@@ -0,0 +1,128 @@
+#include "TextRenderer.h"
+#include <algorithm>
+#include <iostream>
+
+const int ATLAS_WIDTH = 512;
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer, TTF_Font* font, int p_outlineWidth)
+    : texture(nullptr), outlineWidth(p_outlineWidth) {
+    SDL_Color white = {255, 255, 255, 255};
+    std::vector<SDL_Surface*> surfaces;  // Plain glyphs, then outlined ones
+
+    for (int c = FIRST_GLYPH; c <= LAST_GLYPH; ++c) {
+        int advance = 0;
+        TTF_GlyphMetrics(font, c, nullptr, nullptr, nullptr, nullptr, &advance);
+        glyphs[c - FIRST_GLYPH] = {{0, 0, 0, 0}, {0, 0, 0, 0}, advance};
+        surfaces.push_back(TTF_RenderGlyph_Blended(font, c, white));
+    }
+    if (outlineWidth > 0) {
+        int previousOutline = TTF_GetFontOutline(font);
+        TTF_SetFontOutline(font, outlineWidth);
+        for (int c = FIRST_GLYPH; c <= LAST_GLYPH; ++c) {
+            surfaces.push_back(TTF_RenderGlyph_Blended(font, c, white));
+        }
+        TTF_SetFontOutline(font, previousOutline);
+    }
+
+    // Row packing, one pixel apart
+    std::vector<SDL_Rect> placements(surfaces.size(), {0, 0, 0, 0});
+    int penX = 0, penY = 0, rowHeight = 0;
+    for (size_t i = 0; i < surfaces.size(); ++i) {
+        if (!surfaces[i]) continue;
+        if (penX + surfaces[i]->w + 1 > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        placements[i] = {penX, penY, surfaces[i]->w, surfaces[i]->h};
+        penX += surfaces[i]->w + 1;
+        rowHeight = std::max(rowHeight, surfaces[i]->h);
+    }
+
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, std::max(penY + rowHeight, 1), 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface) {
+        SDL_FillRect(atlasSurface, nullptr, 0);
+    } else {
+        std::cerr << "Failed to create glyph atlas: " << SDL_GetError() << std::endl;
+    }
+
+    size_t glyphCount = LAST_GLYPH - FIRST_GLYPH + 1;
+    for (size_t i = 0; i < surfaces.size(); ++i) {
+        if (!surfaces[i]) continue;
+        if (atlasSurface) {
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surfaces[i], nullptr, atlasSurface, &placements[i]);
+        }
+        SDL_FreeSurface(surfaces[i]);
+
+        if (i < glyphCount) {
+            glyphs[i].src = placements[i];
+        } else {
+            glyphs[i - glyphCount].outline = placements[i];
+        }
+    }
+
+    if (atlasSurface) {
+        texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+        SDL_FreeSurface(atlasSurface);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+}
+
+TextRenderer::~TextRenderer() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+const std::vector<TextRenderer::GlyphQuad>& TextRenderer::getLayout(const std::string& text) {
+    auto it = layouts.find(text);
+    if (it != layouts.end()) return it->second;
+
+    if (layouts.size() >= MAX_CACHED_STRINGS) {
+        layouts.clear();  // Mostly changing strings (timers); start over rather than grow
+    }
+
+    std::vector<GlyphQuad> layout;
+    int penX = 0;
+    for (char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) continue;
+        int index = c - FIRST_GLYPH;
+        layout.push_back({index, penX});
+        penX += glyphs[index].advance;
+    }
+    return layouts.emplace(text, std::move(layout)).first->second;
+}
+
+void TextRenderer::drawText(SpriteBatch& batch, const std::string& text, int x, int y, SDL_Color color, int layer) {
+    for (const auto& quad : getLayout(text)) {
+        const SDL_Rect& src = glyphs[quad.glyph].src;
+        batch.draw(texture, src, {x + quad.offsetX, y, src.w, src.h}, layer, color);
+    }
+}
+
+void TextRenderer::drawOutlinedText(SpriteBatch& batch, const std::string& text, int x, int y, SDL_Color color, SDL_Color outlineColor, int layer) {
+    // Same texture and layer, so the outline stays underneath in submission order
+    for (const auto& quad : getLayout(text)) {
+        const SDL_Rect& outline = glyphs[quad.glyph].outline;
+        batch.draw(texture, outline, {x + quad.offsetX - outlineWidth, y - outlineWidth, outline.w, outline.h}, layer, outlineColor);
+    }
+    drawText(batch, text, x, y, color, layer);
+}
+
+void TextRenderer::drawTransientText(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color, int layer) {
+    int penX = 0;
+    for (const char* c = text; *c; ++c) {
+        if (*c < FIRST_GLYPH || *c > LAST_GLYPH) continue;
+        const Glyph& glyph = glyphs[*c - FIRST_GLYPH];
+        batch.draw(texture, glyph.src, {x + penX, y, glyph.src.w, glyph.src.h}, layer, color);
+        penX += glyph.advance;
+    }
+}
+
+int TextRenderer::getTextWidth(const std::string& text) {
+    const auto& layout = getLayout(text);
+    if (layout.empty()) return 0;
+    return layout.back().offsetX + glyphs[layout.back().glyph].advance;
+}
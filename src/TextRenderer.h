@@ -0,0 +1,58 @@
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "SpriteBatch.h"
+
+// Draws text from a glyph atlas built once per font: every printable ASCII
+// glyph is rasterized in white (plus an outlined copy when requested) and
+// strings become tinted quads in a SpriteBatch instead of fresh textures.
+class TextRenderer {
+public:
+    TextRenderer(SDL_Renderer* renderer, TTF_Font* font, int outlineWidth = 0);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    void drawText(SpriteBatch& batch, const std::string& text, int x, int y, SDL_Color color, int layer);
+
+    // Draws the outline glyphs underneath the text (needs outlineWidth > 0)
+    void drawOutlinedText(SpriteBatch& batch, const std::string& text, int x, int y, SDL_Color color, SDL_Color outlineColor, int layer);
+
+    // Lays the string out on the fly instead of caching it, for text that
+    // changes every frame; allocates nothing
+    void drawTransientText(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color, int layer);
+
+    int getTextWidth(const std::string& text);
+
+private:
+    static const char FIRST_GLYPH = 32;
+    static const char LAST_GLYPH = 126;
+    static const size_t MAX_CACHED_STRINGS = 256;
+
+    struct Glyph {
+        SDL_Rect src;      // Rectangle in the atlas
+        SDL_Rect outline;  // Outlined variant, empty if the atlas has none
+        int advance;
+    };
+
+    struct GlyphQuad {
+        int glyph;
+        int offsetX;
+    };
+
+    // Glyph positions of a string, kept between frames
+    const std::vector<GlyphQuad>& getLayout(const std::string& text);
+
+    SDL_Texture* texture;
+    int outlineWidth;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+    std::unordered_map<std::string, std::vector<GlyphQuad>> layouts;
+};
+
+#endif // TEXTRENDERER_H
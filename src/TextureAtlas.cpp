@@ -0,0 +1,110 @@
+#include "TextureAtlas.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <iostream>
+
+TextureAtlas::TextureAtlas(SDL_Renderer* p_renderer, int p_maxSize)
+    : renderer(p_renderer), maxSize(p_maxSize), texture(nullptr) {
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0) {
+        maxSize = std::min({maxSize, info.max_texture_width, info.max_texture_height});
+    }
+}
+
+TextureAtlas::~TextureAtlas() {
+    for (auto& image : pending) {
+        SDL_FreeSurface(image.surface);
+    }
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+bool TextureAtlas::add(const std::string& name, const std::string& path) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) {
+        std::cerr << "Failed to load " << path << " for atlas: " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    // Normalise everything to one pixel format so the images can be blitted as-is
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!converted) {
+        std::cerr << "Failed to convert " << path << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    pending.push_back({name, converted});
+    return true;
+}
+
+bool TextureAtlas::build() {
+    // Shelf packing: tallest images first, each shelf as tall as its first image
+    std::sort(pending.begin(), pending.end(), [](const PendingImage& a, const PendingImage& b) {
+        return a.surface->h > b.surface->h;
+    });
+
+    int shelfX = 0, shelfY = 0, shelfHeight = 0, atlasWidth = 0;
+    for (auto& image : pending) {
+        int w = image.surface->w + PADDING;
+        int h = image.surface->h + PADDING;
+
+        if (shelfX + w > maxSize) {  // Start a new shelf
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (w > maxSize || shelfY + h > maxSize) {
+            std::cerr << "Texture atlas full, could not fit " << image.name << std::endl;
+            return false;
+        }
+
+        regions[image.name] = {shelfX, shelfY, image.surface->w, image.surface->h};
+        shelfX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        atlasWidth = std::max(atlasWidth, shelfX);
+    }
+    int atlasHeight = shelfY + shelfHeight;
+
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, std::max(atlasWidth, 1), std::max(atlasHeight, 1), 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        std::cerr << "Failed to create atlas surface: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_FillRect(atlasSurface, nullptr, 0);
+
+    for (auto& image : pending) {
+        SDL_Rect dest = regions[image.name];
+        SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);  // Copy alpha as-is
+        SDL_BlitSurface(image.surface, nullptr, atlasSurface, &dest);
+        SDL_FreeSurface(image.surface);
+    }
+    pending.clear();
+
+    texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!texture) {
+        std::cerr << "Failed to create atlas texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+SDL_Rect TextureAtlas::getRegion(const std::string& name, const SDL_Rect* src) const {
+    auto it = regions.find(name);
+    if (it == regions.end()) return {0, 0, 0, 0};
+
+    return src ? subRect(it->second, *src) : it->second;
+}
+
+SDL_Rect TextureAtlas::subRect(const SDL_Rect& region, const SDL_Rect& src) {
+    // Clamp to the image like SDL_RenderCopy would, so neighbours never leak in
+    int x = std::max(src.x, 0);
+    int y = std::max(src.y, 0);
+    int w = std::min(src.x + src.w, region.w) - x;
+    int h = std::min(src.y + src.h, region.h) - y;
+    return {region.x + x, region.y + y, std::max(w, 0), std::max(h, 0)};
+}
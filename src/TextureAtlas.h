@@ -0,0 +1,49 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Packs several images into one texture at startup so that draws using any
+// of them can share a single texture binding (and a single batch).
+// Images are added first, then build() shelf-packs them and uploads the atlas.
+class TextureAtlas {
+public:
+    TextureAtlas(SDL_Renderer* p_renderer, int p_maxSize = 2048);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Queues an image for packing under `name`. Returns false if it could not be loaded.
+    bool add(const std::string& name, const std::string& path);
+
+    // Packs every queued image and creates the atlas texture
+    bool build();
+
+    SDL_Texture* getTexture() const { return texture; }
+
+    // Maps a rectangle in the original image (nullptr = whole image) to the atlas
+    SDL_Rect getRegion(const std::string& name, const SDL_Rect* src = nullptr) const;
+    // Same mapping for a region that was already looked up
+    static SDL_Rect subRect(const SDL_Rect& region, const SDL_Rect& src);
+    bool hasRegion(const std::string& name) const { return regions.count(name) > 0; }
+
+private:
+    struct PendingImage {
+        std::string name;
+        SDL_Surface* surface;
+    };
+
+    static const int PADDING = 2;  // Gap between images so filtering never bleeds across them
+
+    SDL_Renderer* renderer;
+    int maxSize;
+    SDL_Texture* texture;
+    std::vector<PendingImage> pending;
+    std::unordered_map<std::string, SDL_Rect> regions;
+};
+
+#endif // TEXTUREATLAS_H
@@ -0,0 +1,44 @@
+#include "TextureCache.h"
+#include <SDL2/SDL_image.h>
+#include <iostream>
+
+TextureCache::TextureCache(SDL_Renderer* p_renderer) : renderer(p_renderer) {}
+
+TextureCache::~TextureCache() {
+    textures.clear();
+}
+
+std::shared_ptr<SDL_Texture> TextureCache::load(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) return it->second;
+
+    SDL_Surface* surface = IMG_Load(path.c_str());
+    if (!surface) {
+        std::cerr << "Failed to load " << path << ": " << IMG_GetError() << std::endl;
+        return nullptr;
+    }
+
+    SDL_Texture* raw = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!raw) {
+        std::cerr << "Failed to create texture for " << path << ": " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    std::shared_ptr<SDL_Texture> texture(raw, SDL_DestroyTexture);
+    textures.emplace(path, texture);
+    return texture;
+}
+
+size_t TextureCache::purgeUnused() {
+    size_t purged = 0;
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.use_count() == 1) {
+            it = textures.erase(it);
+            purged++;
+        } else {
+            ++it;
+        }
+    }
+    return purged;
+}
@@ -0,0 +1,33 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+// Loads each image once and hands out shared handles to the same texture.
+// The cache keeps its own reference, so textures stay resident between users
+// (e.g. across level transitions) until purgeUnused() drops the ones nobody holds.
+class TextureCache {
+public:
+    TextureCache(SDL_Renderer* p_renderer);
+    ~TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // Returns the cached texture for `path`, loading it on first use. Null on failure.
+    std::shared_ptr<SDL_Texture> load(const std::string& path);
+
+    // Destroys textures that are no longer referenced outside the cache
+    size_t purgeUnused();
+
+    size_t getTextureCount() const { return textures.size(); }
+
+private:
+    SDL_Renderer* renderer;
+    std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> textures;
+};
+
+#endif // TEXTURECACHE_H
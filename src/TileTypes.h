@@ -0,0 +1,134 @@
+#ifndef TILETYPES_H
+#define TILETYPES_H
+
+#include <array>
+#include <cstdint>
+#include "GameMap.h"
+#include "Geometry.h"
+#include "SpriteLayer.h"
+
+// Properties of every tile id, built into constant tables at compile time.
+// Collision, lighting and rendering index the tables instead of comparing
+// ids, so a new tile type is one more table entry and no hot-loop change.
+
+// Where an overworld tile's sprite comes from
+enum class TileArt : uint8_t {
+    None,               // Bare grass
+    Tileset,            // `source` in the tileset, or one of its variants
+    PathAutotile,       // Picked from the neighbouring path tiles
+    FenceAutotile,      // Picked from the neighbouring fence tiles
+    EntranceRegion      // The atlas's own dungeon_entrance region
+};
+
+struct TileDescriptor {
+    bool solid;                 // Blocks movement
+    bool occludesLight;
+    TileArt art;
+    Rect source;                // Tileset pixels of the first variant
+    int variants;               // Copies of `source` side by side in the tileset, picked per tile
+    int variantStride;          // Pixels from one variant to the next
+    int offsetX, offsetY;       // Footprint: top-left of the sprite relative to the tile, in tiles
+    int tilesWide, tilesHigh;
+    SpriteLayer layer;
+};
+
+// Dungeon maze values: -1 walls, 0 paths, 2 entrance, 3 exit to the next level
+enum DungeonRegion {
+    DUNGEON_REGION_WALL,
+    DUNGEON_REGION_PATH,
+    DUNGEON_REGION_NONE,        // Drawn as a solid `color` instead
+    DUNGEON_REGION_COUNT = DUNGEON_REGION_NONE
+};
+
+struct DungeonCellDescriptor {
+    bool solid;
+    bool occludesLight;
+    DungeonRegion region;
+    uint8_t color[3];
+};
+
+namespace TileTables {
+    constexpr int SOURCE_SIZE = 32;     // One tileset cell, in pixels
+
+    constexpr TileDescriptor sprite(Rect source, int offsetX = 0, int offsetY = 0, int tilesWide = 1, int tilesHigh = 1) {
+        return {false, false, TileArt::Tileset, source, 1, 0, offsetX, offsetY, tilesWide, tilesHigh, LAYER_GROUND_DETAIL};
+    }
+
+    constexpr TileDescriptor withVariants(TileDescriptor tile, int variants, int stride) {
+        tile.variants = variants;
+        tile.variantStride = stride;
+        return tile;
+    }
+
+    constexpr TileDescriptor withArt(TileDescriptor tile, TileArt art) {
+        tile.art = art;
+        return tile;
+    }
+
+    constexpr TileDescriptor blocking(TileDescriptor tile, bool occludesLight) {
+        tile.solid = true;
+        tile.occludesLight = occludesLight;
+        return tile;
+    }
+
+    constexpr TileDescriptor shading(TileDescriptor tile) {
+        tile.occludesLight = true;
+        return tile;
+    }
+
+    // One entry per TILE_* id, plus a last one (bare grass) for unknown ids
+    constexpr std::array<TileDescriptor, TILE_TYPE_COUNT + 1> buildTileTable() {
+        constexpr int S = SOURCE_SIZE;
+        constexpr TileDescriptor grass = {false, false, TileArt::None, {0, 0, 0, 0}, 1, 0, 0, 0, 1, 1, LAYER_GROUND_DETAIL};
+
+        std::array<TileDescriptor, TILE_TYPE_COUNT + 1> table{};
+        for (auto& tile : table) tile = grass;
+
+        table[TILE_PATH] = withArt(sprite({0, 0, 0, 0}), TileArt::PathAutotile);
+        table[TILE_FENCE] = blocking(withArt(sprite({0, 0, 0, 0}), TileArt::FenceAutotile), false);
+        table[TILE_BUSH] = withVariants(sprite({0, S * 6, S - 12, S - 12}), 4, S);
+        table[TILE_HOUSE_BLUE] = shading(sprite({16, 0, S * 3, S * 3}, -1, -5, 5, 5));
+        table[TILE_HOUSE_RED] = shading(sprite({S * 4, S, S * 2, S * 2}, -1, -4, 5, 4));
+        table[TILE_HOUSE_GREEN] = shading(sprite({S * 6, S, S * 4, S * 2}, 0, -3, 5, 3));
+        table[TILE_TREE] = shading(sprite({S * 10, 0, S * 3 - 25, S * 3}, -2, -3, 3, 4));
+        table[TILE_DUNGEON_ENTRANCE] = withArt(sprite({0, 0, 0, 0}, -2, -3, 5, 3), TileArt::EntranceRegion);
+        table[TILE_GATE] = shading(sprite({0, S * 14 + 9, S * 4, S * 2}, -3, -1, 4, 2));
+        table[TILE_CROSS] = withVariants(sprite({0, S * 12 - 10, S, S + 3}), 4, S);
+        table[TILE_GRAVE] = withVariants(sprite({6, S * 13, S + 4, S + 3}), 2, S);
+        table[TILE_COFFIN] = sprite({6, S * 17 - 15, S * 2, S}, 0, 0, 2, 1);
+        table[TILE_BONE] = sprite({6, S * 18 - 13, S + 4, S});
+        table[TILE_SKULL] = sprite({6, S * 19 - 10, S + 4, S + 3});
+        return table;
+    }
+
+    // Indexed by maze value + 1
+    constexpr std::array<DungeonCellDescriptor, 5> buildDungeonTable() {
+        return {{
+            {true, true, DUNGEON_REGION_WALL, {0, 0, 0}},       // -1 wall
+            {false, false, DUNGEON_REGION_PATH, {0, 0, 0}},     // 0 path
+            {false, false, DUNGEON_REGION_PATH, {0, 0, 0}},     // 1 unused
+            {false, false, DUNGEON_REGION_NONE, {0, 0, 255}},   // 2 entrance, blue
+            {false, false, DUNGEON_REGION_NONE, {255, 0, 0}},   // 3 next level, red
+        }};
+    }
+}
+
+inline constexpr auto TILE_DESCRIPTORS = TileTables::buildTileTable();
+inline constexpr auto DUNGEON_CELL_DESCRIPTORS = TileTables::buildDungeonTable();
+
+// Out-of-range ids get the fallback entry rather than reading past the table
+constexpr const TileDescriptor& tileDescriptor(int tile) {
+    return TILE_DESCRIPTORS[static_cast<unsigned>(tile) < static_cast<unsigned>(TILE_TYPE_COUNT) ? tile : TILE_TYPE_COUNT];
+}
+
+// Values outside the table count as path
+constexpr const DungeonCellDescriptor& dungeonCellDescriptor(int value) {
+    unsigned index = static_cast<unsigned>(value + 1);
+    return DUNGEON_CELL_DESCRIPTORS[index < DUNGEON_CELL_DESCRIPTORS.size() ? index : 1];
+}
+
+static_assert(tileDescriptor(TILE_FENCE).solid && !tileDescriptor(TILE_PATH).solid, "Only fences block movement outdoors");
+static_assert(tileDescriptor(TILE_GRASS).art == TileArt::None && tileDescriptor(-1).art == TileArt::None, "Unknown ids must draw nothing");
+static_assert(dungeonCellDescriptor(-1).solid && !dungeonCellDescriptor(0).solid && !dungeonCellDescriptor(3).solid, "Only -1 is a dungeon wall");
+
+#endif
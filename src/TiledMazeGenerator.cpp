@@ -0,0 +1,148 @@
+#include "TiledMazeGenerator.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+    const int CELL_DX[4] = { 0, 1, 0, -1 };
+    const int CELL_DY[4] = { -1, 0, 1, 0 };
+
+    // Spreads consecutive tile indices across the seed space; plain offsets
+    // would give neighbouring tiles overlapping splitmix sequences
+    uint64_t tileSeed(uint64_t seed, int tile) {
+        return seed ^ (static_cast<uint64_t>(tile + 1) * 0xD1B54A32D192ED03ull);
+    }
+}
+
+TiledMazeGenerator::TiledMazeGenerator(int width, int height, uint64_t seed, int threads, int tileCells)
+    : width(width), height(height), seed(seed), threads(threads), tileCells(std::max(1, tileCells)) {
+    cols = std::max(0, (width - 1) / 2);
+    rows = std::max(0, (height - 1) / 2);
+    tilesX = (cols + this->tileCells - 1) / this->tileCells;
+    tilesY = (rows + this->tileCells - 1) / this->tileCells;
+}
+
+Grid<int> TiledMazeGenerator::generateMaze() {
+    PROFILE_ZONE("TiledMazeGenerator::generateMaze");
+    maze.assign(width, height, -1);
+    int tileCount = tilesX * tilesY;
+    if (tileCount == 0) return std::move(maze);
+
+    int workerCount = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+    workerCount = std::max(1, std::min(workerCount, tileCount));
+
+    // Tiles are handed out one at a time, so uneven tiles along the right
+    // and bottom edges don't leave a worker idle
+    std::atomic<int> nextTile(0);
+    auto work = [this, &nextTile, tileCount] {
+        std::vector<int> stack;
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            carveTile(tile, stack);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < workerCount; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    joinTiles();
+    return std::move(maze);
+}
+
+void TiledMazeGenerator::carveTile(int tile, std::vector<int>& stack) {
+    int x0 = (tile % tilesX) * tileCells;
+    int y0 = (tile / tilesX) * tileCells;
+    int x1 = std::min(x0 + tileCells, cols);
+    int y1 = std::min(y0 + tileCells, rows);
+    Random rng(tileSeed(seed, tile));
+
+    // Recursive backtracker confined to the tile; a cell is visited once its square is open
+    int startX = x0 + static_cast<int>(rng.nextBelow(x1 - x0));
+    int startY = y0 + static_cast<int>(rng.nextBelow(y1 - y0));
+    maze[2 * startY + 1][2 * startX + 1] = 0;
+    stack.clear();
+    stack.push_back(startY * cols + startX);
+
+    while (!stack.empty()) {
+        int cx = stack.back() % cols;
+        int cy = stack.back() / cols;
+
+        int options[4];
+        int optionCount = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = cx + CELL_DX[dir];
+            int ny = cy + CELL_DY[dir];
+            if (nx >= x0 && nx < x1 && ny >= y0 && ny < y1 && maze[2 * ny + 1][2 * nx + 1] == -1) {
+                options[optionCount++] = dir;
+            }
+        }
+        if (optionCount == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        int dir = options[rng.nextBelow(optionCount)];
+        maze[2 * cy + 1 + CELL_DY[dir]][2 * cx + 1 + CELL_DX[dir]] = 0;
+        cx += CELL_DX[dir];
+        cy += CELL_DY[dir];
+        maze[2 * cy + 1][2 * cx + 1] = 0;
+        stack.push_back(cy * cols + cx);
+    }
+}
+
+void TiledMazeGenerator::joinTiles() {
+    // Randomized depth-first search over the tiles; every tree edge opens one
+    // wall on the border the two tiles share
+    Random rng(seed);
+    int tileCount = tilesX * tilesY;
+    std::vector<char> visited(tileCount, 0);
+    std::vector<int> stack;
+    int start = static_cast<int>(rng.nextBelow(tileCount));
+    visited[start] = 1;
+    stack.push_back(start);
+
+    while (!stack.empty()) {
+        int tx = stack.back() % tilesX;
+        int ty = stack.back() / tilesX;
+
+        int options[4];
+        int optionCount = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = tx + CELL_DX[dir];
+            int ny = ty + CELL_DY[dir];
+            if (nx >= 0 && nx < tilesX && ny >= 0 && ny < tilesY && !visited[ny * tilesX + nx]) {
+                options[optionCount++] = dir;
+            }
+        }
+        if (optionCount == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        int dir = options[rng.nextBelow(optionCount)];
+        int nx = tx + CELL_DX[dir];
+        int ny = ty + CELL_DY[dir];
+        if (CELL_DX[dir] != 0) {
+            // Side by side: open the wall column between them at a random row
+            int wallX = 2 * std::max(tx, nx) * tileCells;
+            int y0 = ty * tileCells;
+            int y1 = std::min(y0 + tileCells, rows);
+            int cy = y0 + static_cast<int>(rng.nextBelow(y1 - y0));
+            maze[2 * cy + 1][wallX] = 0;
+        } else {
+            int wallY = 2 * std::max(ty, ny) * tileCells;
+            int x0 = tx * tileCells;
+            int x1 = std::min(x0 + tileCells, cols);
+            int cx = x0 + static_cast<int>(rng.nextBelow(x1 - x0));
+            maze[wallY][2 * cx + 1] = 0;
+        }
+        visited[ny * tilesX + nx] = 1;
+        stack.push_back(ny * tilesX + nx);
+    }
+}
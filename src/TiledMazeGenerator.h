@@ -0,0 +1,38 @@
+#ifndef TILEDMAZEGENERATOR_H
+#define TILEDMAZEGENERATOR_H
+
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "Random.h"
+
+// Generates very large mazes on several threads. The cells are split into
+// square tiles, each carved as its own perfect maze by whichever worker
+// picks it up, from a generator seeded by the tile's index. The tiles are
+// then joined along a random spanning tree of the tile grid, one opening per
+// tree edge, so the whole maze is still perfect.
+// Tiles only write inside their own bounds and the seeds don't depend on
+// which thread runs a tile, so the maze is the same for any thread count.
+class TiledMazeGenerator {
+public:
+    static const int DEFAULT_TILE_CELLS = 64;   // Tile edge, in cells
+
+    // threads <= 0 uses every hardware thread
+    TiledMazeGenerator(int width, int height, uint64_t seed, int threads = 0, int tileCells = DEFAULT_TILE_CELLS);
+    Grid<int> generateMaze();   // Same format as MazeGenerator: -1 walls, 0 paths, cells on odd coordinates
+
+private:
+    int width;
+    int height;
+    uint64_t seed;
+    int threads;
+    int tileCells;
+    int cols, rows;             // In cells
+    int tilesX, tilesY;
+    Grid<int> maze;
+
+    void carveTile(int tile, std::vector<int>& stack);
+    void joinTiles();
+};
+
+#endif
@@ -1,11 +1,60 @@
 #include "World.h"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 #include "GameMap.h"  // Include your map header to use mapMatrix
+#include "TileTypes.h"
+#include "Profiler.h"
 
 const int TILE_SIZE = 96;
 const int TILE_SOURCE_SIZE = 32;
+const size_t MAX_RESIDENT_CHUNKS = 64;  // Unloaded chunks kept in memory before spilling to region files
 
-World::World(SDL_Renderer* p_renderer) : renderer(p_renderer), chunkSize(12), terminateThread(false) {
+// Chunks within LOAD_RADIUS of the player are loaded, but only unloaded once
+// they are past UNLOAD_RADIUS, so walking along a chunk border does not thrash
+const int LOAD_RADIUS = 2;
+const int UNLOAD_RADIUS = 3;
+const float PREFETCH_SECONDS = 1.5f;  // How far ahead along the player's velocity to prefetch
+
+// Farthest any tile's sprite reaches past its own tile, so chunks just outside
+// the camera still get drawn when something of theirs overhangs into view
+static constexpr int maxTileOverhang() {
+    int overhang = 0;
+    for (const TileDescriptor& tile : TILE_DESCRIPTORS) {
+        overhang = std::max({overhang, -tile.offsetX, -tile.offsetY,
+                             tile.offsetX + tile.tilesWide - 1, tile.offsetY + tile.tilesHigh - 1});
+    }
+    return overhang;
+}
+
+// FNV-1a over the map's size and tiles, so region files from an edited map are not reused
+static uint64_t hashMap(const std::vector<std::vector<int>>& matrix) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+
+    mix(matrix.size());
+    for (const auto& row : matrix) {
+        mix(row.size());
+        for (int tile : row) mix(static_cast<uint32_t>(tile));
+    }
+    return hash;
+}
+
+static int floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+World::World(SDL_Renderer* p_renderer, const std::string& regionDirectory)
+    : renderer(p_renderer), chunkSize(12), terminateThread(false),
+      mapWidth(mapMatrix.empty() ? 0 : static_cast<int>(mapMatrix[0].size())), mapHeight(static_cast<int>(mapMatrix.size())),
+      chunkStore(regionDirectory, MAX_RESIDENT_CHUNKS, chunkSize, hashMap(mapMatrix)),
+      lastPlayerX(0.0f), lastPlayerY(0.0f), lastUpdateTime(0), velocityX(0.0f), velocityY(0.0f) {
+    for (auto& bucket : eventBuckets) bucket.fill(0);
+    bucketSeconds.fill(0);
+    eventTotals.fill(0);
     generationThread = std::thread(&World::mapGenerationThread, this);
 }
 
@@ -18,9 +67,16 @@ World::~World() {
     if (generationThread.joinable()) {
         generationThread.join();
     }
+
+    // Hand the active window over too, so the store writes it out with the
+    // rest and the next World pages it back in rather than rebuilding it
+    for (const auto& [key, chunk] : chunks) {
+        chunkStore.store(static_cast<int>(static_cast<uint32_t>(key >> 32)), static_cast<int>(static_cast<uint32_t>(key & 0xffffffff)), chunk);
+    }
 }
 
 void World::mapGenerationThread() {
+    Profiler::setThreadName("World generation");
     while (true) {
         std::pair<int, int> chunkCoords;
         {
@@ -36,49 +92,158 @@ void World::mapGenerationThread() {
 }
 
 void World::requestChunkGeneration(int chunkX, int chunkY) {
+    if (!isChunkInsideMap(chunkX, chunkY)) return;  // Nothing there to stream
+
+    ChunkKey key = getChunkKey(chunkX, chunkY);
+
     std::lock_guard<std::mutex> lock(chunkMutex);
+    if (chunks.find(key) != chunks.end() || !requestedChunks.insert(key).second) return;  // Loaded or already queued
     chunkQueue.push({chunkX, chunkY});
     cv.notify_one();  // Notify the thread that there's a new chunk to generate
 }
 
 void World::generateChunk(int chunkX, int chunkY) {
-    std::string key = getChunkKey(chunkX, chunkY);
-    
-    // Lock the mutex while modifying the chunks map
+    PROFILE_ZONE("World::generateChunk");
+    ChunkKey key = getChunkKey(chunkX, chunkY);
+
     {
         std::lock_guard<std::mutex> lock(chunkMutex);
-        if (chunks.find(key) != chunks.end()) return;  // Chunk already exists
-        chunks[key] = mapMatrix;  // For simplicity, assume mapMatrix is static for this example
+        if (chunks.find(key) != chunks.end()) {  // Chunk already exists
+            requestedChunks.erase(key);
+            loadedCv.notify_all();
+            return;
+        }
+    }
+
+    // Page the chunk back in if it was visited before, otherwise build it
+    Chunk chunk;
+    bool regenerated = false;
+    if (!chunkStore.load(chunkX, chunkY, chunk)) {
+        // Edge chunks are cut short where the map ends
+        int left = chunkX * chunkSize;
+        int top = chunkY * chunkSize;
+        chunk = Chunk::fromMatrix(mapMatrix, left, top, std::min(chunkSize, mapWidth - left), std::min(chunkSize, mapHeight - top));
+        regenerated = true;
+    }
+
+    // Lock the mutex while modifying the chunks map
+    std::lock_guard<std::mutex> lock(chunkMutex);
+    requestedChunks.erase(key);
+    chunks.emplace(key, std::move(chunk));
+    recordChunkEvent(ChunkLoaded);
+    if (regenerated) {
+        recordChunkEvent(ChunkRegenerated);
     }
+    loadedCv.notify_all();
+}
+
+void World::waitForRequestedChunks() {
+    std::unique_lock<std::mutex> lock(chunkMutex);
+    loadedCv.wait(lock, [this] { return requestedChunks.empty(); });
 }
 
 void World::update(float playerX, float playerY) {
-    int centerX = static_cast<int>(playerX) / (chunkSize * TILE_SIZE);
-    int centerY = static_cast<int>(playerY) / (chunkSize * TILE_SIZE);
+    PROFILE_ZONE("World::update");
+    float chunkPixels = static_cast<float>(chunkSize * TILE_SIZE);
+    updateVelocity(playerX, playerY);
+
+    int centerX = static_cast<int>(std::floor(playerX / chunkPixels));
+    int centerY = static_cast<int>(std::floor(playerY / chunkPixels));
 
-    std::unordered_set<std::string> newVisibleChunks;
+    // Chunk the player is heading towards
+    int aheadX = static_cast<int>(std::floor((playerX + velocityX * PREFETCH_SECONDS) / chunkPixels));
+    int aheadY = static_cast<int>(std::floor((playerY + velocityY * PREFETCH_SECONDS) / chunkPixels));
+
+    for (int x = centerX - LOAD_RADIUS; x <= centerX + LOAD_RADIUS; ++x) {
+        for (int y = centerY - LOAD_RADIUS; y <= centerY + LOAD_RADIUS; ++y) {
+            requestChunkGeneration(x, y);  // Request chunk generation in background
+        }
+    }
 
-    for (int x = centerX - 2; x <= centerX + 2; ++x) {
-        for (int y = centerY - 2; y <= centerY + 2; ++y) {
-            std::string key = getChunkKey(x, y);
-            if (chunks.find(key) == chunks.end()) {
-                requestChunkGeneration(x, y);  // Request chunk generation in background
+    // Prefetch the neighbourhood ahead so it is ready before the player gets there
+    if (aheadX != centerX || aheadY != centerY) {
+        for (int x = aheadX - LOAD_RADIUS; x <= aheadX + LOAD_RADIUS; ++x) {
+            for (int y = aheadY - LOAD_RADIUS; y <= aheadY + LOAD_RADIUS; ++y) {
+                requestChunkGeneration(x, y);
             }
-            newVisibleChunks.insert(key);
         }
     }
 
-    // Remove chunks that are no longer visible
-    for (const auto& chunkKey : visibleChunks) {
-        if (newVisibleChunks.find(chunkKey) == newVisibleChunks.end()) {
-            chunks.erase(chunkKey);  // Despawn the chunk
+    // Hand chunks outside the unload radius (and not prefetched) over to the chunk store
+    std::lock_guard<std::mutex> lock(chunkMutex);
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        int chunkX = static_cast<int>(static_cast<uint32_t>(it->first >> 32));
+        int chunkY = static_cast<int>(static_cast<uint32_t>(it->first & 0xffffffff));
+
+        bool nearPlayer = std::abs(chunkX - centerX) <= UNLOAD_RADIUS && std::abs(chunkY - centerY) <= UNLOAD_RADIUS;
+        bool ahead = std::abs(chunkX - aheadX) <= LOAD_RADIUS && std::abs(chunkY - aheadY) <= LOAD_RADIUS;
+
+        if (!nearPlayer && !ahead) {
+            chunkStore.store(chunkX, chunkY, it->second);
+            it = chunks.erase(it);
+            recordChunkEvent(ChunkUnloaded);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void World::updateVelocity(float playerX, float playerY) {
+    Uint32 now = SDL_GetTicks();
+    float elapsed = (now - lastUpdateTime) / 1000.0f;
+    float dx = playerX - lastPlayerX;
+    float dy = playerY - lastPlayerY;
+    float chunkPixels = static_cast<float>(chunkSize * TILE_SIZE);
+
+    if (lastUpdateTime == 0 || std::abs(dx) > chunkPixels || std::abs(dy) > chunkPixels) {
+        // First update or a teleport (e.g. leaving the dungeon): nothing to extrapolate
+        velocityX = 0.0f;
+        velocityY = 0.0f;
+    } else if (elapsed > 0.0f) {
+        // Smooth out per-frame jitter
+        const float smoothing = 0.2f;
+        velocityX += (dx / elapsed - velocityX) * smoothing;
+        velocityY += (dy / elapsed - velocityY) * smoothing;
+    }
+
+    lastPlayerX = playerX;
+    lastPlayerY = playerY;
+    lastUpdateTime = now;
+}
+
+void World::recordChunkEvent(ChunkEvent event) {
+    Uint32 second = SDL_GetTicks() / 1000;
+    size_t index = second % eventBuckets.size();
+    if (bucketSeconds[index] != second) {
+        bucketSeconds[index] = second;
+        eventBuckets[index].fill(0);
+    }
+    eventBuckets[index][event]++;
+    eventTotals[event]++;
+}
+
+ChunkStats World::getChunkStats() {
+    std::lock_guard<std::mutex> lock(chunkMutex);
+    Uint32 second = SDL_GetTicks() / 1000;
+
+    std::array<unsigned long, CHUNK_EVENT_COUNT> lastMinute{};
+    for (size_t i = 0; i < eventBuckets.size(); ++i) {
+        if (second - bucketSeconds[i] < eventBuckets.size()) {
+            for (int event = 0; event < CHUNK_EVENT_COUNT; ++event) {
+                lastMinute[event] += eventBuckets[i][event];
+            }
         }
     }
 
-    visibleChunks = newVisibleChunks;
+    return {
+        eventTotals[ChunkLoaded], eventTotals[ChunkUnloaded], eventTotals[ChunkRegenerated],
+        lastMinute[ChunkLoaded], lastMinute[ChunkUnloaded], lastMinute[ChunkRegenerated],
+        chunks.size()
+    };
 }
 
-void World::render(float playerX, float playerY, bool isPlayerInDungeon, SDL_Rect dungeonEntrance, const SDL_Rect& camera, SDL_Texture* dungeonEntranceTexture, SDL_Texture* tilesetTexture) {
+void World::render(float playerX, float playerY, bool isPlayerInDungeon, SDL_Rect dungeonEntrance, const SDL_Rect& camera, SpriteBatch& batch, const TextureAtlas& atlas) {
+    PROFILE_ZONE("World::render");
     std::lock_guard<std::mutex> lock(chunkMutex);  // Protect access to chunks
 
     // Define shadow parameters
@@ -86,8 +251,8 @@ void World::render(float playerX, float playerY, bool isPlayerInDungeon, SDL_Rec
     const Uint8 shadowAlpha = 128; // Shadow transparency
 
     // Calculate the world rendering area (shadow area)
-    int worldWidth = mapMatrix[0].size() * TILE_SIZE;
-    int worldHeight = mapMatrix.size() * TILE_SIZE;
+    int worldWidth = mapWidth * TILE_SIZE;
+    int worldHeight = mapHeight * TILE_SIZE;
 
     SDL_Rect shadowRect = {
         -camera.x + shadowOffset,
@@ -96,122 +261,86 @@ void World::render(float playerX, float playerY, bool isPlayerInDungeon, SDL_Rec
         worldHeight
     };
 
-    // Set the renderer color for the shadow (semi-transparent black)
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, shadowAlpha);
-
-    // Render the shadow
-    SDL_RenderFillRect(renderer, &shadowRect);
-
-    // Render visible chunks
-    for (const auto& [chunkKey, chunk] : chunks) {
-        for (int y = 0; y < chunk.size(); ++y) {
-            for (int x = 0; x < chunk[y].size(); ++x) {
-                SDL_Rect destRect = {
-                    x * TILE_SIZE - camera.x,
-                    y * TILE_SIZE - camera.y,
-                    TILE_SIZE,
-                    TILE_SIZE
-                };
-
-                // Always render grass first as the base layer
-                SDL_Rect grassSrcRect = {TILE_SOURCE_SIZE * 9, TILE_SOURCE_SIZE * 4, TILE_SOURCE_SIZE, TILE_SOURCE_SIZE};
-                SDL_RenderCopy(renderer, tilesetTexture, &grassSrcRect, &destRect);
-
-                // Now render other elements on top of the grass
-                SDL_Rect srcRect;
-                bool renderTile = true;
-
-                // Switch case handling different tile types in the chunk
-                switch (chunk[y][x]) {
-                    case TILE_PATH:
-                        srcRect = getPathTileSourceRect(x, y); // Determine which path tile to use
-                        break;
-                    case TILE_FENCE:
-                        srcRect = getFenceTileSourceRect(x, y);
-                        break;
-                    case TILE_BUSH:
-                        srcRect = {bushIndex * TILE_SOURCE_SIZE, TILE_SOURCE_SIZE * 6, TILE_SOURCE_SIZE - 12, TILE_SOURCE_SIZE - 12};
-                        bushIndex = (bushIndex + 1) % 4;
-                        break;
-                    case TILE_HOUSE_BLUE:
-                        srcRect = {16, 0, TILE_SOURCE_SIZE * 3, TILE_SOURCE_SIZE * 3}; // Blue house
-                        destRect.x = (x - 1) * TILE_SIZE - camera.x; // Adjust x-position to include the left tile
-                        destRect.y = (y - 5) * TILE_SIZE - camera.y;
-                        destRect.w = TILE_SIZE * 5;
-                        destRect.h = TILE_SIZE * 5;
-                        break;
-                    case TILE_HOUSE_RED:
-                        srcRect = {TILE_SOURCE_SIZE * 4, TILE_SOURCE_SIZE, TILE_SOURCE_SIZE * 2, TILE_SOURCE_SIZE * 2};
-                        destRect.x = (x - 1) * TILE_SIZE - camera.x;
-                        destRect.y = (y - 4) * TILE_SIZE - camera.y;
-                        destRect.w = TILE_SIZE * 5;
-                        destRect.h = TILE_SIZE * 4;
-                        break;
-                    case TILE_TREE:
-                        srcRect = {TILE_SOURCE_SIZE * 10, 0, TILE_SIZE - 25, TILE_SIZE}; // Tree
-                        destRect.x = (x - 2) * TILE_SIZE - camera.x; // Adjust x-position to include the left tile
-                        destRect.y = (y - 3) * TILE_SIZE - camera.y;
-                        destRect.w = TILE_SIZE * 3;
-                        destRect.h = TILE_SIZE * 4;
-                        break;
-                    case TILE_DUNGEON_ENTRANCE:
-                        destRect.x = (x - 2) * TILE_SIZE - camera.x; // Adjust x-position to include the left tile
-                        destRect.y = (y - 3) * TILE_SIZE - camera.y;
-                        destRect.w = TILE_SIZE * 5;
-                        destRect.h = TILE_SIZE * 3;
-                        if (!isPlayerInDungeon) {
-                            SDL_RenderCopy(renderer, dungeonEntranceTexture, nullptr, &destRect);
-                        }
-                        renderTile = false;
-                    case TILE_GATE:
-                        srcRect = {0, TILE_SOURCE_SIZE * 14 + 9, TILE_SOURCE_SIZE * 4, TILE_SOURCE_SIZE * 2};
-                        destRect.x = (x - 3) * TILE_SIZE - camera.x; // Adjust x-position to include the left tile
-                        destRect.y = (y - 1) * TILE_SIZE - camera.y;
-                        destRect.w = TILE_SIZE * 4;
-                        destRect.h = TILE_SIZE * 2;
-                        break;
-                    case TILE_CROSS:
-                        srcRect = {crossIndex * TILE_SOURCE_SIZE, TILE_SOURCE_SIZE * 12 - 10, TILE_SOURCE_SIZE, TILE_SOURCE_SIZE + 3};
-                        crossIndex = (crossIndex + 1) % 4;
-                        break;
-                    case TILE_GRAVE:
-                        srcRect = {graveIndex * TILE_SOURCE_SIZE + 6, TILE_SOURCE_SIZE * 13, TILE_SOURCE_SIZE + 4, TILE_SOURCE_SIZE + 3};
-                        graveIndex = (graveIndex + 1) % 2;
-                        break;
-                    case TILE_COFFIN:
-                        srcRect = {6, TILE_SOURCE_SIZE * 17 - 15, TILE_SOURCE_SIZE * 2, TILE_SOURCE_SIZE};
-                        destRect.w = TILE_SIZE * 2;
-                        break;
-                    case TILE_BONE:
-                        srcRect = {6, TILE_SOURCE_SIZE * 18 - 13, TILE_SOURCE_SIZE + 4, TILE_SOURCE_SIZE};
-                        break;
-                    case TILE_SKULL:
-                        srcRect = {6, TILE_SOURCE_SIZE * 19 - 10, TILE_SOURCE_SIZE + 4, TILE_SOURCE_SIZE + 3};
-                        break;
-                    case TILE_HOUSE_GREEN:
-                        srcRect = {TILE_SOURCE_SIZE * 6, TILE_SOURCE_SIZE, TILE_SOURCE_SIZE * 4, TILE_SOURCE_SIZE * 2};
-                        destRect.y = (y - 3) * TILE_SIZE - camera.y;
-                        destRect.w = TILE_SIZE * 5;
-                        destRect.h = TILE_SIZE * 3;
-                        break;
-                    default:
-                        renderTile = false;
-                        break;
-                }
+    // Render the shadow (semi-transparent black)
+    batch.fillRect(shadowRect, {0, 0, 0, shadowAlpha}, LAYER_BACKGROUND);
+
+    SDL_Texture* atlasTexture = atlas.getTexture();
+    SDL_Rect entranceRegion = atlas.getRegion("dungeon_entrance");
+    SDL_Rect grassSrcRect = {TILE_SOURCE_SIZE * 9, TILE_SOURCE_SIZE * 4, TILE_SOURCE_SIZE, TILE_SOURCE_SIZE};
+    SDL_Rect tilesetRegion = atlas.getRegion("tileset");
+    SDL_Rect grassRegion = TextureAtlas::subRect(tilesetRegion, grassSrcRect);
+
+    // Render only the chunks that intersect the camera, widened by the largest sprite overhang
+    int chunkPixels = chunkSize * TILE_SIZE;
+    int margin = maxTileOverhang() * TILE_SIZE;
+    int firstChunkX = floorDiv(camera.x - margin, chunkPixels);
+    int firstChunkY = floorDiv(camera.y - margin, chunkPixels);
+    int lastChunkX = floorDiv(camera.x + camera.w + margin, chunkPixels);
+    int lastChunkY = floorDiv(camera.y + camera.h + margin, chunkPixels);
+
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            auto found = chunks.find(getChunkKey(chunkX, chunkY));
+            if (found == chunks.end()) continue;
+            const Chunk& chunk = found->second;
+            int originX = chunkX * chunkSize;  // World tile of the chunk's top-left corner
+            int originY = chunkY * chunkSize;
+
+            for (int y = 0; y < chunk.getHeight(); ++y) {
+                for (int x = 0; x < chunk.getWidth(); ++x) {
+                    int tileX = originX + x;
+                    int tileY = originY + y;
+                    SDL_Rect destRect = {
+                        tileX * TILE_SIZE - camera.x,
+                        tileY * TILE_SIZE - camera.y,
+                        TILE_SIZE,
+                        TILE_SIZE
+                    };
+
+                    // Always render grass first as the base layer
+                    batch.draw(atlasTexture, grassRegion, destRect, LAYER_GROUND);
+
+                    // Then whatever stands on it, as the tile's descriptor describes it
+                    const TileDescriptor& tile = tileDescriptor(chunk.getTile(x, y));
+                    if (tile.art == TileArt::None) continue;
+
+                    destRect.x = (tileX + tile.offsetX) * TILE_SIZE - camera.x;
+                    destRect.y = (tileY + tile.offsetY) * TILE_SIZE - camera.y;
+                    destRect.w = tile.tilesWide * TILE_SIZE;
+                    destRect.h = tile.tilesHigh * TILE_SIZE;
 
-                if (renderTile) {
-                    SDL_RenderCopy(renderer, tilesetTexture, &srcRect, &destRect);
+                    // Variants are picked by position, so a tile keeps its look from frame to frame
+                    int variant = (tileX + tileY * 3) % tile.variants;
+                    SDL_Rect srcRect = {tile.source.x + variant * tile.variantStride, tile.source.y, tile.source.w, tile.source.h};
+
+                    SDL_Rect region;
+                    switch (tile.art) {
+                        case TileArt::PathAutotile:
+                            region = TextureAtlas::subRect(tilesetRegion, getPathTileSourceRect(chunk, chunkX, chunkY, x, y));
+                            break;
+                        case TileArt::FenceAutotile:
+                            region = TextureAtlas::subRect(tilesetRegion, getFenceTileSourceRect(chunk, chunkX, chunkY, x, y));
+                            break;
+                        case TileArt::EntranceRegion:
+                            if (isPlayerInDungeon) continue;
+                            region = entranceRegion;
+                            break;
+                        default:
+                            region = TextureAtlas::subRect(tilesetRegion, srcRect);
+                            break;
+                    }
+                    batch.draw(atlasTexture, region, destRect, tile.layer);
                 }
             }
         }
     }
 }
 
-SDL_Rect World::getFenceTileSourceRect(int x, int y) {
-    bool up = y > 0 && mapMatrix[y - 1][x] == TILE_FENCE;
-    bool down = y < mapMatrix.size() - 1 && mapMatrix[y + 1][x] == TILE_FENCE;
-    bool left = x > 0 && mapMatrix[y][x - 1] == TILE_FENCE;
-    bool right = x < mapMatrix[y].size() - 1 && mapMatrix[y][x + 1] == TILE_FENCE;
+SDL_Rect World::getFenceTileSourceRect(const Chunk& chunk, int chunkX, int chunkY, int x, int y) const {
+    bool up = getTile(chunk, chunkX, chunkY, x, y - 1) == TILE_FENCE;
+    bool down = getTile(chunk, chunkX, chunkY, x, y + 1) == TILE_FENCE;
+    bool left = getTile(chunk, chunkX, chunkY, x - 1, y) == TILE_FENCE;
+    bool right = getTile(chunk, chunkX, chunkY, x + 1, y) == TILE_FENCE;
 
     // Check for corners first
     if (left && up) {
@@ -240,11 +369,11 @@ SDL_Rect World::getFenceTileSourceRect(int x, int y) {
 }
 
 // Determine which path tile to use based on surrounding tiles
-SDL_Rect World::getPathTileSourceRect(int x, int y) {
-    bool up = y > 0 && mapMatrix[y - 1][x] == TILE_PATH;
-    bool down = y < mapMatrix.size() - 1 && mapMatrix[y + 1][x] == TILE_PATH;
-    bool left = x > 0 && mapMatrix[y][x - 1] == TILE_PATH;
-    bool right = x < mapMatrix[y].size() - 1 && mapMatrix[y][x + 1] == TILE_PATH;
+SDL_Rect World::getPathTileSourceRect(const Chunk& chunk, int chunkX, int chunkY, int x, int y) const {
+    bool up = getTile(chunk, chunkX, chunkY, x, y - 1) == TILE_PATH;
+    bool down = getTile(chunk, chunkX, chunkY, x, y + 1) == TILE_PATH;
+    bool left = getTile(chunk, chunkX, chunkY, x - 1, y) == TILE_PATH;
+    bool right = getTile(chunk, chunkX, chunkY, x + 1, y) == TILE_PATH;
 
     if (!left && right) {
         // Path tile with grass on the left side
@@ -264,7 +393,31 @@ SDL_Rect World::getPathTileSourceRect(int x, int y) {
     }
 }
 
-// Helper to convert chunk coordinates to a string key
-std::string World::getChunkKey(int chunkX, int chunkY) {
-    return std::to_string(chunkX) + "," + std::to_string(chunkY);
+// Helper to pack chunk coordinates into a single key
+World::ChunkKey World::getChunkKey(int chunkX, int chunkY) const {
+    return (static_cast<ChunkKey>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+}
+
+bool World::isChunkInsideMap(int chunkX, int chunkY) const {
+    return chunkX >= 0 && chunkY >= 0 && chunkX * chunkSize < mapWidth && chunkY * chunkSize < mapHeight;
+}
+
+// Tile at (x, y) relative to `chunk`, reaching into the neighbouring chunk when
+// that falls outside it. Tiles off the map or in unloaded chunks read as grass.
+int World::getTile(const Chunk& chunk, int chunkX, int chunkY, int x, int y) const {
+    if (x >= 0 && y >= 0 && x < chunk.getWidth() && y < chunk.getHeight()) {
+        return chunk.getTile(x, y);
+    }
+
+    int tileX = chunkX * chunkSize + x;
+    int tileY = chunkY * chunkSize + y;
+    int neighbourX = floorDiv(tileX, chunkSize);
+    int neighbourY = floorDiv(tileY, chunkSize);
+    auto found = chunks.find(getChunkKey(neighbourX, neighbourY));
+    if (found == chunks.end()) return TILE_GRASS;
+
+    int localX = tileX - neighbourX * chunkSize;
+    int localY = tileY - neighbourY * chunkSize;
+    if (localX >= found->second.getWidth() || localY >= found->second.getHeight()) return TILE_GRASS;
+    return found->second.getTile(localX, localY);
 }
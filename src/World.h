@@ -7,43 +7,79 @@
 #include <string>
 #include <SDL2/SDL.h>
 #include "Entity.h"
+#include "Chunk.h"
+#include "ChunkStore.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
 
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <condition_variable>
+#include <array>
+
+// Chunk streaming counters. The per-minute figures cover the last 60 seconds.
+struct ChunkStats {
+    unsigned long totalLoads;
+    unsigned long totalUnloads;
+    unsigned long totalRegenerations;
+    unsigned long loadsPerMinute;
+    unsigned long unloadsPerMinute;
+    unsigned long regenerationsPerMinute;
+    size_t loadedChunks;
+};
 
 class World {
 public:
-    World(SDL_Renderer* p_renderer);
+    World(SDL_Renderer* p_renderer, const std::string& regionDirectory = "");
     ~World();
     void update(float playerX, float playerY);
-    void render(float playerX, float playerY, bool isPlayerInDungeon, SDL_Rect dungeonEntrance, const SDL_Rect& camera, SDL_Texture* dungeonEntranceTexture, SDL_Texture* tilesetTexture);
+    void waitForRequestedChunks();  // Blocks until every chunk requested so far is loaded
+    ChunkStats getChunkStats();
+    void render(float playerX, float playerY, bool isPlayerInDungeon, SDL_Rect dungeonEntrance, const SDL_Rect& camera, SpriteBatch& batch, const TextureAtlas& atlas);
     
 private:
+    using ChunkKey = unsigned long long;
+
     void generateChunk(int chunkX, int chunkY);
-    std::string getChunkKey(int chunkX, int chunkY);
+    ChunkKey getChunkKey(int chunkX, int chunkY) const;
+    bool isChunkInsideMap(int chunkX, int chunkY) const;
+    int getTile(const Chunk& chunk, int chunkX, int chunkY, int x, int y) const;  // Caller holds chunkMutex
 
     // Threading related members
     void mapGenerationThread(); // Function for the background thread
     void requestChunkGeneration(int chunkX, int chunkY); // Add chunk to queue
+    void updateVelocity(float playerX, float playerY);
+
+    enum ChunkEvent { ChunkLoaded, ChunkUnloaded, ChunkRegenerated, CHUNK_EVENT_COUNT };
+    void recordChunkEvent(ChunkEvent event);  // Caller holds chunkMutex
 
     std::thread generationThread;
     std::mutex chunkMutex;  // Mutex to protect access to chunks
     std::condition_variable cv;  // For thread notification
+    std::condition_variable loadedCv;  // Signalled whenever a requested chunk is done
     std::queue<std::pair<int, int>> chunkQueue;  // Queue of chunks to generate
+    std::unordered_set<ChunkKey> requestedChunks;  // Queued but not generated yet
     bool terminateThread;  // Flag to stop the background thread
 
-    SDL_Rect getPathTileSourceRect(int x, int y);
-    SDL_Rect getFenceTileSourceRect(int x, int y);
-    int bushIndex;
-    int crossIndex;
-    int graveIndex;
+    SDL_Rect getPathTileSourceRect(const Chunk& chunk, int chunkX, int chunkY, int x, int y) const;
+    SDL_Rect getFenceTileSourceRect(const Chunk& chunk, int chunkX, int chunkY, int x, int y) const;
     
     SDL_Renderer* renderer;
     int chunkSize;
-    std::unordered_map<std::string, std::vector<std::vector<int>>> chunks;
-    std::unordered_set<std::string> visibleChunks; // Keep track of visible chunks
+    int mapWidth, mapHeight;  // Source map size in tiles; chunks are chunkSize x chunkSize windows of it
+    std::unordered_map<ChunkKey, Chunk> chunks;
+    ChunkStore chunkStore;  // Unloaded chunks (and, on shutdown, the rest), paged back in on revisit or next run
+
+    // Player velocity in pixels per second, used to prefetch chunks ahead
+    float lastPlayerX, lastPlayerY;
+    Uint32 lastUpdateTime;
+    float velocityX, velocityY;
+
+    // One bucket of event counts per second over the last minute
+    std::array<std::array<unsigned long, CHUNK_EVENT_COUNT>, 60> eventBuckets;
+    std::array<Uint32, 60> bucketSeconds;
+    std::array<unsigned long, CHUNK_EVENT_COUNT> eventTotals;
 };
 
 #endif // WORLD_H
@@ -1,19 +1,135 @@
 #include "Game.h"
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
 
 Game* game = nullptr;                                     /* Game pointer */
 
 int main(int argc, char* argv[]) {
     game = new Game();                                    /* Alocating memory for the game */
 
-    game->init("Game Window", 1920, 1080, false);         /* Method for initializing the game */
+    /* --headless [--levels N]: simulate without a window, for soak tests and benchmarks */
+    /* --endless: the dungeon is one bottomless maze, generated as the player descends */
+    /* --seed N: reproduce the mazes, spawns, AI and combat rolls of an earlier run */
+    /* --record FILE: save this session's input; --replay FILE [--timing CSV]: play one back */
+    /* --profile FILE: time the major subsystems and write a Chrome trace on exit */
+    /* --scenario NAME|all [--frames N] [--baseline FILE [--threshold PCT]] [--save-baseline FILE]: */
+    /*   time scripted scenarios offscreen and fail if p95/p99 frame times regress past the baseline */
+    bool headless = false;
+    bool endless = false;
+    int levels = 1000;
+    unsigned long long seed = static_cast<unsigned long long>(std::time(nullptr));
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* timingPath = "";
+    const char* profilePath = nullptr;
+    const char* scenario = nullptr;
+    int scenarioFrames = 600;
+    const char* baselinePath = nullptr;
+    const char* saveBaselinePath = nullptr;
+    double threshold = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--endless") == 0) {
+            endless = true;
+        } else if (strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+            levels = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--timing") == 0 && i + 1 < argc) {
+            timingPath = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            scenarioFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--save-baseline") == 0 && i + 1 < argc) {
+            saveBaselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        }
+    }
 
-    while (game->running()) {
-        game->handleEvents();
-        game->update();
-        game->render();
-    }                                                     /* Game loop */
+    InputLog replay;
+    if (replayPath) {
+        if (!replay.load(replayPath)) return 1;
+        seed = replay.getSeed();                          /* A replay only matches with the recorded seed */
+    }
+    RandomService::seed(seed);
 
-    game->clean();                                        /* Cleaning the memmory */
+    if (profilePath) {
+        Profiler::setEnabled(true);                       /* Before init, so worker threads get named */
+        Profiler::setThreadName("Main");
+    }
 
-    return 0;
+    if (scenario) {
+        /* Offscreen, software-rendered and silent, so scenarios run on a box without a GPU or display */
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+
+    if (headless && !scenario) {
+        game->initHeadless();
+    } else {
+        game->init("Game Window", 1920, 1080, false);     /* Method for initializing the game */
+    }
+
+    game->setEndlessMode(endless);
+
+    int exitCode = 0;
+    if (scenario) {
+        std::vector<ScenarioResult> results;
+        for (int i = 0; i < SCENARIO_COUNT; ++i) {
+            if (strcmp(scenario, "all") != 0 && strcmp(scenario, SCENARIO_NAMES[i]) != 0) continue;
+            ScenarioResult result;
+            if (game->runScenario(SCENARIO_NAMES[i], scenarioFrames, result)) results.push_back(result);
+        }
+
+        std::vector<ScenarioResult> baseline;
+        if (results.empty()) {
+            fprintf(stderr, "Unknown scenario %s\n", scenario);
+            exitCode = 1;
+        } else if (baselinePath) {
+            if (!loadScenarioBaseline(baselinePath, baseline) || !compareScenarioResults(baseline, results, threshold / 100.0)) {
+                exitCode = 1;
+            }
+        }
+        if (saveBaselinePath && !results.empty() && saveScenarioBaseline(saveBaselinePath, results)) {
+            printf("Scenario baseline written to %s\n", saveBaselinePath);
+        }
+    } else if (replayPath) {
+        game->runReplay(replay, timingPath);
+    } else if (headless) {
+        game->runHeadless(levels);
+    } else {
+        if (recordPath) game->startRecording(recordPath);
+
+        while (game->running()) {
+            Profiler::beginFrame();
+            game->handleEvents();
+            game->update();
+            game->render();
+            Profiler::endFrame();
+        }                                                 /* Game loop */
+
+        game->stopRecording();
+    }
+
+    delete game;                                          /* Stops and joins every worker thread, then cleans up */
+    game = nullptr;
+
+    if (profilePath && Profiler::exportChromeTrace(profilePath)) {
+        printf("Profile written to %s\n", profilePath);  /* No thread can still be recording zones */
+    }
+
+    return exitCode;
 }